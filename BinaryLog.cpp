@@ -0,0 +1,200 @@
+#include "BinaryLog.h"
+#include "FlightRecorder.h"
+#include <fstream>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <iostream>
+
+// File layout (little-endian):
+//   header:  "GSPYBLOG", version byte, wall-clock anchor (int64 microseconds since the Unix
+//            epoch), event count (varint), then per event: level byte, name, template
+//   record:  event ID (varint), microseconds since the previous record (varint),
+//            argument count byte, then per argument a type byte and its payload:
+//            integer = zigzag varint, real = 8-byte double, string = length varint + bytes
+// Strings in the header use the same length-prefixed form. Records are appended in the
+// order they are logged, so the delta chain gives each one a monotonic timestamp.
+static const char binary_log_magic[8] = {'G', 'S', 'P', 'Y', 'B', 'L', 'O', 'G'};
+static const unsigned char binary_log_version = 1;
+static const size_t binary_buffer_limit = 1 << 16;
+static const size_t binary_string_limit = 0xFFFF;
+
+struct LogEventInfo {
+    const char* name;
+    LogLevel level;
+    const char* text;
+};
+
+#define GSPY_LOG_EVENT_INFO(name, level, text) {#name, level, text},
+static const LogEventInfo log_events[] = { GSPY_LOG_EVENTS(GSPY_LOG_EVENT_INFO) };
+#undef GSPY_LOG_EVENT_INFO
+
+static std::ofstream binary_file;
+static std::vector<char> binary_buffer;
+static std::mutex binary_mutex;
+static std::atomic<bool> binary_open{false};
+static std::chrono::steady_clock::time_point binary_last_time;
+
+static void put_varint(std::vector<char>& out, unsigned long long value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+static void put_string(std::vector<char>& out, const char* data, size_t size) {
+    if (size > binary_string_limit) size = binary_string_limit;
+    put_varint(out, size);
+    out.insert(out.end(), data, data + size);
+}
+
+static void put_arg(std::vector<char>& out, const LogArg& arg) {
+    out.push_back(static_cast<char>(arg.type));
+    switch (arg.type) {
+    case LogArg::Integer: {
+        unsigned long long bits = static_cast<unsigned long long>(arg.integer);
+        put_varint(out, (bits << 1) ^ (arg.integer < 0 ? ~0ULL : 0ULL));
+        break;
+    }
+    case LogArg::Real: {
+        char bytes[sizeof(double)];
+        memcpy(bytes, &arg.real, sizeof(double));
+        out.insert(out.end(), bytes, bytes + sizeof(double));
+        break;
+    }
+    case LogArg::String:
+        put_string(out, arg.string.data, arg.string.size);
+        break;
+    }
+}
+
+// Caller holds binary_mutex
+static void write_buffer() {
+    if (!binary_buffer.empty()) {
+        binary_file.write(binary_buffer.data(), binary_buffer.size());
+        binary_buffer.clear();
+    }
+}
+
+// Appends one record; returns false if the binary log is closed
+static bool write_binary_record(LogEvent event, const LogArg* args, size_t count) {
+    if (!binary_open.load(std::memory_order_acquire)) return false;
+
+    std::lock_guard<std::mutex> lock(binary_mutex);
+    if (!binary_file.is_open()) return false;
+
+    // The clock is read under the lock so deltas never go negative across threads
+    auto now = std::chrono::steady_clock::now();
+    auto delta = std::chrono::duration_cast<std::chrono::microseconds>(now - binary_last_time).count();
+    binary_last_time += std::chrono::microseconds(delta);
+
+    put_varint(binary_buffer, static_cast<unsigned long long>(event));
+    put_varint(binary_buffer, static_cast<unsigned long long>(delta));
+    binary_buffer.push_back(static_cast<char>(count));
+    for (size_t i = 0; i < count; ++i) put_arg(binary_buffer, args[i]);
+
+    if (binary_buffer.size() >= binary_buffer_limit) write_buffer();
+    return true;
+}
+
+bool WriteBinaryLogText(const std::string& message) {
+    LogArg arg(message);
+    return write_binary_record(LogEvent::Text, &arg, 1);
+}
+
+std::atomic<bool> record_all_events{false};
+
+std::string FormatLogEvent(LogEvent event, const LogArg* args, size_t count) {
+    const char* text = log_events[static_cast<size_t>(event)].text;
+    std::string out;
+    const LogArg* arg = args;
+    for (const char* p = text; *p; ++p) {
+        if (p[0] == '{' && p[1] == '}' && arg != args + count) {
+            switch (arg->type) {
+            case LogArg::Integer: out += std::to_string(arg->integer); break;
+            case LogArg::Real:    out += std::to_string(arg->real); break;
+            case LogArg::String:  out.append(arg->string.data, arg->string.size); break;
+            }
+            ++arg;
+            ++p;
+        }
+        else {
+            out += *p;
+        }
+    }
+    return out;
+}
+
+void LogEventRecord(LogEvent event, std::initializer_list<LogArg> args) {
+    if (record_all_events.load(std::memory_order_relaxed)) {
+        RecordFlightEvent(event, args.begin(), args.size());
+    }
+    LogLevel level = LogEventLevel(event);
+    if (level > GSPY_COMPILED_LOG_LEVEL || !ShouldLog(level)) {
+        return;
+    }
+    if (level == LOG_DEBUG && write_binary_record(event, args.begin(), args.size())) {
+        return;
+    }
+
+    static const char* prefixes[] = {"ERROR: ", "WARNING: ", "INFO: ", "DEBUG: "};
+    Log(prefixes[level] + FormatLogEvent(event, args), level);
+}
+
+bool OpenBinaryLog(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(binary_mutex);
+    if (binary_file.is_open()) return true;
+
+    binary_file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!binary_file.is_open()) {
+        return false;
+    }
+
+    binary_buffer.clear();
+    binary_buffer.reserve(binary_buffer_limit + 1024);
+    binary_buffer.insert(binary_buffer.end(), binary_log_magic, binary_log_magic + sizeof(binary_log_magic));
+    binary_buffer.push_back(static_cast<char>(binary_log_version));
+
+    // Anchor the steady clock to wall-clock time once; records only carry steady deltas
+    long long anchor = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    binary_last_time = std::chrono::steady_clock::now();
+    char bytes[sizeof(long long)];
+    memcpy(bytes, &anchor, sizeof(long long));
+    binary_buffer.insert(binary_buffer.end(), bytes, bytes + sizeof(long long));
+
+    const size_t event_count = static_cast<size_t>(LogEvent::Count);
+    put_varint(binary_buffer, event_count);
+    for (size_t i = 0; i < event_count; ++i) {
+        binary_buffer.push_back(static_cast<char>(log_events[i].level));
+        put_string(binary_buffer, log_events[i].name, strlen(log_events[i].name));
+        put_string(binary_buffer, log_events[i].text, strlen(log_events[i].text));
+    }
+    write_buffer();
+    binary_file.flush();
+
+    binary_open.store(true, std::memory_order_release);
+    return true;
+}
+
+void FlushBinaryLog() {
+    if (!binary_open.load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> lock(binary_mutex);
+    write_buffer();
+    binary_file.flush();
+}
+
+void CloseBinaryLog() {
+    binary_open.store(false, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(binary_mutex);
+    if (binary_file.is_open()) {
+        write_buffer();
+        binary_file.close();
+    }
+}
+
+bool IsBinaryLogOpen() {
+    return binary_open.load(std::memory_order_acquire);
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "Logger.h"
+#include <string>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+#include <atomic>
+
+// Structured log events: name, level and the text template ("{}" marks each argument).
+// The binary log stores the event ID and the raw arguments; the template is only applied
+// when the record goes to the text log or when the binary file is decoded. IDs are the
+// position in this list, so append new events at the end.
+#define GSPY_LOG_EVENTS(X) \
+    X(Text,               LOG_DEBUG, "{}") \
+    X(MethodCalled,       LOG_DEBUG, "GSPy called with MethodID: {}") \
+    X(StatusSet,          LOG_DEBUG, "Status set to: {}") \
+    X(PreparingInputs,    LOG_DEBUG, "Preparing {} input argument(s) for Python.") \
+    X(InputType,          LOG_DEBUG, "  Input #{}: Type='{}'") \
+    X(PythonCallDone,     LOG_DEBUG, "Python call successful. Processing {} result(s).") \
+    X(OutputType,         LOG_DEBUG, "  Output #{}: Type='{}'") \
+    X(OutputReused,       LOG_DEBUG, "  Output #{}: inputs unchanged, reusing cached value.") \
+    X(OutputRecomputed,   LOG_DEBUG, "  Output #{}: recomputing.") \
+    X(TsMetadata,         LOG_DEBUG, "  TS Metadata: {} = {}") \
+    X(TsVectorOut,        LOG_DEBUG, "  Python->GoldSim: Vector time series, num_rows = {}") \
+    X(TsMatrixOut,        LOG_DEBUG, "  Python->GoldSim: Matrix time series, num_rows = {}, num_cols = {}") \
+    X(TsHeaderBasis,      LOG_DEBUG, "  Python->GoldSim: Writing header - ts_id=20.0, format=-3.0, time_basis={}, data_type={}") \
+    X(TsHeaderShape,      LOG_DEBUG, "  Python->GoldSim: Writing header - num_rows={}, num_cols={}, num_series={}") \
+    X(TsWriteSeries,      LOG_DEBUG, "  Python->GoldSim: Writing {} series of {} timestamps and {} data values") \
+    X(TsDecimated,        LOG_DEBUG, "  Python->GoldSim: Decimated series {} from {} to {} points ({})") \
+    X(TsBuilderWritten,   LOG_DEBUG, "  Python->GoldSim: Wrote {} point(s) from gspy.TimeSeriesBuilder") \
+    X(TsArrayNdim,        LOG_DEBUG, "  Python->GoldSim: Array ndim = {}") \
+    X(Table3DDimensions,  LOG_DEBUG, "  3D Table dimensions: {} rows, {} cols, {} layers") \
+    X(TableInput,         LOG_DEBUG, "  Table input: {}D, sizes {} x {} x {}") \
+    X(InputSize,          LOG_DEBUG, "  Input #{} '{}': {} value(s)") \
+    X(OutputSize,         LOG_DEBUG, "  Output #{} '{}': {} value(s) written") \
+    X(CalcTiming,         LOG_DEBUG, "Calculation #{}: inputs {} us, Python {} us, outputs {} us") \
+    X(GraphTiming,        LOG_DEBUG, "Calculation #{}: inputs {} us, output graph {} us")
+
+#define GSPY_LOG_EVENT_ID(name, level, text) name,
+enum class LogEvent : unsigned short { GSPY_LOG_EVENTS(GSPY_LOG_EVENT_ID) Count };
+#undef GSPY_LOG_EVENT_ID
+
+#define GSPY_LOG_EVENT_LEVEL(name, level, text) case LogEvent::name: return level;
+constexpr LogLevel LogEventLevel(LogEvent event) {
+    switch (event) { GSPY_LOG_EVENTS(GSPY_LOG_EVENT_LEVEL) default: return LOG_DEBUG; }
+}
+#undef GSPY_LOG_EVENT_LEVEL
+
+// One typed argument. Integers, doubles and strings are captured as-is (strings by pointer,
+// valid for the duration of the logging call); nothing is converted to text up front.
+struct LogArg {
+    enum Type : unsigned char { Integer = 1, Real = 2, String = 3 };
+    Type type;
+    union {
+        long long integer;
+        double real;
+        struct { const char* data; size_t size; } string;
+    };
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    LogArg(T value) : type(Integer), integer(static_cast<long long>(value)) {}
+    LogArg(double value) : type(Real), real(value) {}
+    LogArg(const char* value) : type(String), string{value, strlen(value)} {}
+    LogArg(const std::string& value) : type(String), string{value.data(), value.size()} {}
+    LogArg(const char* data, size_t size) : type(String), string{data, size} {}
+};
+
+// Set while the flight recorder is running: events are then captured even when their level
+// is disabled, and LogEventRecord decides what reaches the log
+extern std::atomic<bool> record_all_events;
+
+// Logs a structured event. DEBUG events go to the binary log while it is open; otherwise the
+// template is filled in and the record is written to the text log like any other message.
+// The flight recorder, when running, gets every event whatever the level.
+void LogEventRecord(LogEvent event, std::initializer_list<LogArg> args);
+
+// Fills in the event's template the way the text log shows it (integers in decimal, doubles
+// as std::to_string prints them), without the level prefix
+std::string FormatLogEvent(LogEvent event, const LogArg* args, size_t count);
+inline std::string FormatLogEvent(LogEvent event, std::initializer_list<LogArg> args) {
+    return FormatLogEvent(event, args.begin(), args.size());
+}
+
+// Level check (or a running flight recorder) first, then the event is recorded with its
+// arguments unconverted
+#define GSPY_LOG_EVENT(event, ...) \
+    do { \
+        if ((LogEventLevel(LogEvent::event) <= GSPY_COMPILED_LOG_LEVEL && ShouldLog(LogEventLevel(LogEvent::event))) || \
+            record_all_events.load(std::memory_order_relaxed)) { \
+            LogEventRecord(LogEvent::event, {__VA_ARGS__}); \
+        } \
+    } while (0)
+
+// Opens (truncates) the binary log and writes its header, including the event table, so
+// files from any GSPy version can be decoded. While it is open every DEBUG record is written
+// there instead of the text log. Returns false if the file cannot be created.
+bool OpenBinaryLog(const std::string& filename);
+
+// Writes buffered binary records to the file
+void FlushBinaryLog();
+
+// Flushes and closes the binary log; DEBUG records go to the text log again
+void CloseBinaryLog();
+
+bool IsBinaryLogOpen();
+
+// Writes an already formatted DEBUG message as a Text event. Returns false (and writes
+// nothing) when the binary log is closed. Used by Log() for plain-text DEBUG records.
+bool WriteBinaryLogText(const std::string& message);
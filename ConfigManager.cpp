@@ -76,4 +76,52 @@ int GetLogLevel() {
         catch (json::parse_error&) { /* Fall through to default */ }
     }
     return default_level;
-}
\ No newline at end of file
+}
+
+// Parses the config file into data; false if it is missing or malformed
+static bool read_config_json(json& data) {
+    std::ifstream f(GetConfigFilename());
+    if (!f.is_open()) return false;
+    try {
+        data = json::parse(f);
+        return true;
+    }
+    catch (json::parse_error&) {
+        return false;
+    }
+}
+
+bool GetLogAsync() {
+    json data;
+    return read_config_json(data) && data.value("log_async", false);
+}
+
+int GetLogQueueSize() {
+    // 8192 slots of 256 bytes: 2 MB of queued records
+    json data;
+    return read_config_json(data) ? data.value("log_queue_size", 8192) : 8192;
+}
+
+bool GetLogOverflowBlocks() {
+    json data;
+    return read_config_json(data) && data.value("log_overflow", "drop") == "block";
+}
+
+bool GetLogBinary() {
+    json data;
+    return read_config_json(data) && data.value("log_binary", false);
+}
+
+std::string GetBinaryLogFilename() {
+    std::string log_filename = GetLogFilename();
+    size_t dot_pos = log_filename.find_last_of(".");
+    if (dot_pos != std::string::npos && log_filename.find_first_of("/\\", dot_pos) == std::string::npos) {
+        return log_filename.substr(0, dot_pos) + ".bin";
+    }
+    return log_filename + ".bin";
+}
+
+int GetFlightRecorderSize() {
+    json data;
+    return read_config_json(data) ? data.value("flight_recorder", 0) : 0;
+}
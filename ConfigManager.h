@@ -9,3 +9,18 @@ std::string GetLogFilename();
 
 // Get the log level from config (0=ERROR, 1=WARNING, 2=INFO, 3=DEBUG)
 int GetLogLevel();
+
+// Asynchronous logging settings from config: "log_async" (default false), "log_queue_size"
+// (ring buffer slots, default 8192) and "log_overflow" ("drop" (default) or "block")
+bool GetLogAsync();
+int GetLogQueueSize();
+bool GetLogOverflowBlocks();
+
+// Binary structured log: "log_binary" (default false) and the file it goes to, next to the
+// text log with a .bin extension (e.g., my_script_log.bin)
+bool GetLogBinary();
+std::string GetBinaryLogFilename();
+
+// Number of recent events kept by the in-memory flight recorder ("flight_recorder",
+// default 0, which leaves it off)
+int GetFlightRecorderSize();
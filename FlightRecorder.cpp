@@ -0,0 +1,193 @@
+#include "FlightRecorder.h"
+#include "Logger.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <exception>
+#include <cstdio>
+#include <cstdlib>
+#ifdef _WIN32
+    #include <Windows.h>
+#endif
+#if defined(_M_X64) || defined(__x86_64__)
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+    #define GSPY_FLIGHT_TSC
+#endif
+
+static const size_t flight_max_args = 4;
+
+// One recorded event. String arguments are copied into text; their value slot holds the
+// offset (high bits) and length (low 16 bits) within it.
+struct FlightSlot {
+    long long time;                     // flight_clock() ticks
+    unsigned short event;
+    unsigned char count;
+    unsigned char types[flight_max_args];
+    union { long long integer; double real; } values[flight_max_args];
+    char text[80];
+};
+static_assert(sizeof(FlightSlot) == 128, "FlightSlot should be exactly two cache lines");
+
+static std::unique_ptr<FlightSlot[]> flight_slots;
+static size_t flight_capacity = 0;
+static std::atomic<size_t> flight_head{0};      // Next position to write
+static std::atomic<size_t> flight_dumped{0};    // Everything before this has been dumped
+
+// Slots are stamped with the CPU timestamp counter, a few cycles to read where steady_clock
+// costs tens of nanoseconds. Dumps convert ticks to time using the steady_clock interval
+// measured since the recorder started.
+static long long flight_clock() {
+#ifdef GSPY_FLIGHT_TSC
+    return static_cast<long long>(__rdtsc());
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+static long long flight_start_ticks = 0;
+static std::chrono::steady_clock::time_point flight_start_time;
+
+static std::terminate_handler previous_terminate = nullptr;
+#ifdef _WIN32
+static LPTOP_LEVEL_EXCEPTION_FILTER previous_exception_filter = nullptr;
+#endif
+
+void RecordFlightEvent(LogEvent event, const LogArg* args, size_t count) {
+    if (!record_all_events.load(std::memory_order_acquire)) return;
+
+    size_t position = flight_head.fetch_add(1, std::memory_order_relaxed);
+    FlightSlot& slot = flight_slots[position & (flight_capacity - 1)];
+    slot.time = flight_clock();
+    slot.event = static_cast<unsigned short>(event);
+    slot.count = static_cast<unsigned char>(count < flight_max_args ? count : flight_max_args);
+
+    size_t used = 0;
+    for (size_t i = 0; i < slot.count; ++i) {
+        slot.types[i] = args[i].type;
+        if (args[i].type == LogArg::String) {
+            size_t size = args[i].string.size;
+            if (size > sizeof(slot.text) - used) size = sizeof(slot.text) - used;
+            memcpy(slot.text + used, args[i].string.data, size);
+            slot.values[i].integer = static_cast<long long>((used << 16) | size);
+            used += size;
+        }
+        else if (args[i].type == LogArg::Real) {
+            slot.values[i].real = args[i].real;
+        }
+        else {
+            slot.values[i].integer = args[i].integer;
+        }
+    }
+}
+
+static std::string format_slot(const FlightSlot& slot, long long now, double ticks_per_ms) {
+    LogArg args[flight_max_args] = {0, 0, 0, 0};
+    for (size_t i = 0; i < slot.count; ++i) {
+        if (slot.types[i] == LogArg::String) {
+            size_t packed = static_cast<size_t>(slot.values[i].integer);
+            args[i] = LogArg(slot.text + (packed >> 16), packed & 0xFFFF);
+        }
+        else if (slot.types[i] == LogArg::Real) {
+            args[i] = LogArg(slot.values[i].real);
+        }
+        else {
+            args[i] = LogArg(slot.values[i].integer);
+        }
+    }
+
+    static const char* prefixes[] = {"ERROR: ", "WARNING: ", "INFO: ", "DEBUG: "};
+    LogEvent event = static_cast<LogEvent>(slot.event);
+    double age_ms = static_cast<double>(now - slot.time) / ticks_per_ms;
+    char age[32];
+    snprintf(age, sizeof(age), "  [-%.3f ms] ", age_ms);
+    return age + std::string(prefixes[LogEventLevel(event)]) + FormatLogEvent(event, args, slot.count);
+}
+
+void DumpFlightRecorder(const std::string& reason, bool crashing) {
+    if (!record_all_events.load(std::memory_order_acquire)) return;
+
+    size_t head = flight_head.load(std::memory_order_acquire);
+    size_t first = flight_dumped.exchange(head, std::memory_order_acq_rel);
+    if (head <= first) return;
+    if (head - first > flight_capacity) first = head - flight_capacity;
+
+    long long now = flight_clock();
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - flight_start_time).count();
+    double ticks_per_ms = elapsed_ms > 0.0 && now > flight_start_ticks ? static_cast<double>(now - flight_start_ticks) / elapsed_ms : 1e6;
+    std::string dump = "===== GSPy flight recorder: last " + std::to_string(head - first) + " event(s) before " + reason + " =====\n";
+    for (size_t position = first; position < head; ++position) {
+        dump += format_slot(flight_slots[position & (flight_capacity - 1)], now, ticks_per_ms);
+        dump += '\n';
+    }
+    dump += "===== End of flight recorder =====";
+
+    if (crashing) {
+        TryLogAlways(dump);
+    }
+    else {
+        LogAlways(dump);
+    }
+}
+
+static void on_terminate() {
+    DumpFlightRecorder("abnormal termination", true);
+    if (previous_terminate != nullptr) previous_terminate();
+    std::abort();
+}
+
+#ifdef _WIN32
+// Access violations and other structured exceptions that nothing else handled
+static LONG WINAPI on_unhandled_exception(EXCEPTION_POINTERS* info) {
+    char code[48];
+    snprintf(code, sizeof(code), "unhandled exception 0x%08lX", static_cast<unsigned long>(info->ExceptionRecord->ExceptionCode));
+    DumpFlightRecorder(code, true);
+    return previous_exception_filter != nullptr ? previous_exception_filter(info) : EXCEPTION_CONTINUE_SEARCH;
+}
+#endif
+
+void StartFlightRecorder(size_t capacity) {
+    if (record_all_events.load(std::memory_order_acquire) || capacity == 0) return;
+
+    size_t rounded = 16;
+    while (rounded < capacity) rounded <<= 1;
+    if (rounded != flight_capacity) {
+        flight_slots.reset(new FlightSlot[rounded]);
+        flight_capacity = rounded;
+    }
+    flight_head.store(0, std::memory_order_relaxed);
+    flight_dumped.store(0, std::memory_order_relaxed);
+    flight_start_ticks = flight_clock();
+    flight_start_time = std::chrono::steady_clock::now();
+
+    previous_terminate = std::set_terminate(on_terminate);
+#ifdef _WIN32
+    previous_exception_filter = SetUnhandledExceptionFilter(on_unhandled_exception);
+#endif
+    record_all_events.store(true, std::memory_order_release);
+}
+
+void StopFlightRecorder() {
+    if (!record_all_events.exchange(false, std::memory_order_acq_rel)) return;
+
+    // The handlers are process-wide and every renamed copy of the DLL installs its own. Only
+    // put the previous handler back while ours is still the installed one; if another copy
+    // has installed its handler since, replacing it would leave it pointing at a stale chain.
+    if (std::get_terminate() == on_terminate) {
+        std::set_terminate(previous_terminate);
+    }
+    previous_terminate = nullptr;
+#ifdef _WIN32
+    LPTOP_LEVEL_EXCEPTION_FILTER installed = SetUnhandledExceptionFilter(previous_exception_filter);
+    if (installed != on_unhandled_exception) {
+        SetUnhandledExceptionFilter(installed);
+    }
+    previous_exception_filter = nullptr;
+#endif
+}
+
+bool IsFlightRecorderRunning() {
+    return record_all_events.load(std::memory_order_acquire);
+}
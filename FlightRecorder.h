@@ -0,0 +1,36 @@
+#pragma once
+#include "BinaryLog.h"
+#include <string>
+#include <cstddef>
+
+// In-memory flight recorder: a fixed ring of the most recent structured events (method IDs,
+// input/output sizes, phase timings and every GSPY_LOG_EVENT site), recorded whatever the
+// log level. Nothing is formatted or written unless something goes wrong; the ring is then
+// dumped to the log so failures at log_level 0 still come with context.
+
+// Starts recording the last `capacity` events (rounded up to a power of two) and installs
+// the abnormal-termination handlers. No-op while already running.
+void StartFlightRecorder(size_t capacity);
+
+// Stops recording and restores the previous termination handlers if this DLL's handlers are
+// still the installed ones (the DLL may be unloaded next)
+void StopFlightRecorder();
+
+bool IsFlightRecorderRunning();
+
+// Copies one event into the ring. Strings are truncated to fit the slot.
+void RecordFlightEvent(LogEvent event, const LogArg* args, size_t count);
+
+// Writes the events recorded since the last dump to the log, oldest first, regardless of
+// log_level. `reason` heads the dump. From a crash handler, pass crashing = true: the dump then
+// gives up rather than wait for a log lock the crashed thread may hold.
+void DumpFlightRecorder(const std::string& reason, bool crashing = false);
+
+// Records an event for the flight recorder only; it never reaches the log directly
+#define GSPY_RECORD_EVENT(event, ...) \
+    do { \
+        if (record_all_events.load(std::memory_order_relaxed)) { \
+            LogArg gspy_record_args[] = {__VA_ARGS__}; \
+            RecordFlightEvent(LogEvent::event, gspy_record_args, sizeof(gspy_record_args) / sizeof(LogArg)); \
+        } \
+    } while (0)
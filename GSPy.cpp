@@ -3,6 +3,7 @@
 #include "PythonManager.h"
 #include <string>
 #include "Logger.h"
+#include "FlightRecorder.h"
 #include "ConfigManager.h"
 
 extern "C" void GSPy(int methodID, int* status, double* inargs, double* outargs)
@@ -10,15 +11,29 @@ extern "C" void GSPy(int methodID, int* status, double* inargs, double* outargs)
     try {
         // Initialize the logger once using the new ConfigManager
         static bool logger_initialized = false;
+        static bool log_async = false;
+        static int flight_recorder_size = 0;
         if (!logger_initialized) {
             std::string log_filename = GetLogFilename();
             int log_level = GetLogLevel(); // Get from config file
             InitLogger(log_filename, static_cast<LogLevel>(log_level));
             SetLogLevelFromInt(log_level); // Apply log level atomically
+            log_async = GetLogAsync();
+            flight_recorder_size = GetFlightRecorderSize();
+            if (GetLogBinary() && !OpenBinaryLog(GetBinaryLogFilename())) {
+                LogWarning("Could not create the binary log '" + GetBinaryLogFilename() + "'; DEBUG records stay in the text log.");
+            }
             logger_initialized = true;
         }
+        // The writer thread stops at cleanup and restarts with the next run in this process
+        if (log_async && !IsAsyncLoggerRunning()) {
+            StartAsyncLogger(static_cast<size_t>(GetLogQueueSize()), GetLogOverflowBlocks() ? LogOverflow::Block : LogOverflow::Drop);
+        }
+        if (flight_recorder_size > 0 && !IsFlightRecorderRunning()) {
+            StartFlightRecorder(static_cast<size_t>(flight_recorder_size));
+        }
 
-        LogDebug("GSPy called with MethodID: " + std::to_string(methodID));
+        GSPY_LOG_EVENT(MethodCalled, methodID);
 
         *status = 0;
         std::string errorMessage;
@@ -34,14 +49,14 @@ extern "C" void GSPy(int methodID, int* status, double* inargs, double* outargs)
         case 1: // Calculate
             ExecuteCalculation(inargs, outargs, errorMessage);
             if (!errorMessage.empty()) {
-                LogDebug("Sending error to GoldSim: " + errorMessage);
+                GSPY_LOG_DEBUG("Sending error to GoldSim: " + errorMessage);
                 SendErrorToGoldSim(errorMessage, status, outargs);
-                LogDebug("Error sent to GoldSim successfully");
+                GSPY_LOG_DEBUG("Error sent to GoldSim successfully");
             }
             break;
 
         case 2: // Report Version
-            LogInfo("Reporting version to GoldSim: " + std::string(GSPY_VERSION));
+            GSPY_LOG_INFO("Reporting version to GoldSim: " + std::string(GSPY_VERSION));
             outargs[0] = GSPY_VERSION_DOUBLE;
             break;
 
@@ -57,6 +72,9 @@ extern "C" void GSPy(int methodID, int* status, double* inargs, double* outargs)
 
         case 99: // Cleanup
             FinalizePython();
+            StopFlightRecorder();
+            StopAsyncLogger();
+            FlushBinaryLog();
             break;
 
         default:
@@ -66,11 +84,13 @@ extern "C" void GSPy(int methodID, int* status, double* inargs, double* outargs)
     }
     catch (const std::exception& e) {
         LogError(std::string("C++ exception caught in GSPy: ") + e.what());
+        DumpFlightRecorder(std::string("C++ exception: ") + e.what());
         std::string errorMsg = std::string("C++ exception: ") + e.what();
         SendErrorToGoldSim(errorMsg, status, outargs);
     }
     catch (...) {
         LogError("Unknown C++ exception caught in GSPy");
+        DumpFlightRecorder("unknown C++ exception");
         std::string errorMsg = "Unknown C++ exception in GSPy";
         SendErrorToGoldSim(errorMsg, status, outargs);
     }
@@ -1,5 +1,6 @@
 #include "GSPy_Error.h"
 #include "Logger.h"
+#include "FlightRecorder.h"
 #include <cstring> // For strncpy_s
 
 // The static buffer now lives here, dedicated to our error messenger.
@@ -19,5 +20,11 @@ void SendErrorToGoldSim(const std::string& message, int* status, double* outargs
     // Use status = 1 for generic failure (not -1 which expects a pointer)
     *status = 1;
     
-    LogDebug("Status set to: " + std::to_string(*status));
+    GSPY_LOG_EVENT(StatusSet, *status);
+
+    // The events leading up to the error, even at log_level 0
+    DumpFlightRecorder("error: " + message);
+
+    // With asynchronous or binary logging, make sure the error is on disk before GoldSim stops the run
+    FlushLog();
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+#ifdef _DEBUG
+    #undef _DEBUG
+    #include <Python.h>
+    #define _DEBUG
+#else
+    #include <Python.h>
+#endif
+
+#include "InputChangeTracker.h"
+#include "Logger.h"
+#include <cstring>
+#include <unordered_map>
+
+static bool tracking_enabled = false;
+static std::unordered_map<std::string, size_t> input_indices;
+
+// Snapshot of the previous inargs block and where each input lived inside it
+static std::vector<double> previous_block;
+static std::vector<InputSlice> previous_slices;
+
+// One flag per configured input for the current call
+static std::vector<char> changed_flags;
+
+void ResetInputChangeTracking(const nlohmann::json& config) {
+    tracking_enabled = config.value("track_changes", false);
+
+    // Dependency-graph outputs need change information to decide what to recompute
+    for (const auto& output : config["outputs"]) {
+        if (output.contains("function")) tracking_enabled = true;
+    }
+
+    input_indices.clear();
+    const auto& inputs = config["inputs"];
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        input_indices[inputs[i].value("name", "")] = i;
+    }
+
+    previous_block.clear();
+    previous_slices.clear();
+    changed_flags.assign(inputs.size(), 1);
+
+    if (tracking_enabled) {
+        GSPY_LOG_DEBUG("Input change tracking enabled for " + std::to_string(inputs.size()) + " input(s).");
+    }
+}
+
+bool IsInputChangeTrackingEnabled() {
+    return tracking_enabled;
+}
+
+void UpdateInputChanges(const double* inargs, const std::vector<InputSlice>& slices) {
+    if (!tracking_enabled) return;
+
+    size_t block_length = 0;
+    changed_flags.assign(slices.size(), 1);
+    for (size_t i = 0; i < slices.size(); ++i) {
+        const InputSlice& slice = slices[i];
+        block_length = slice.offset + slice.length;
+
+        // An input is unchanged only if it kept its size and every double is bit-identical.
+        // memcmp is vectorised by the CRT and also treats a repeated NaN as unchanged.
+        if (i < previous_slices.size() && previous_slices[i].length == slice.length) {
+            const double* previous = previous_block.data() + previous_slices[i].offset;
+            changed_flags[i] = memcmp(previous, inargs + slice.offset, slice.length * sizeof(double)) != 0;
+        }
+    }
+
+    previous_block.assign(inargs, inargs + block_length);
+    previous_slices = slices;
+}
+
+bool InputChanged(size_t index) {
+    if (!tracking_enabled || index >= changed_flags.size()) return true;
+    return changed_flags[index] != 0;
+}
+
+PyObject* PythonChanged(PyObject* self, PyObject* args) {
+    const char* name = nullptr;
+
+    // Parse arguments: name (optional)
+    if (!PyArg_ParseTuple(args, "|z", &name)) {
+        return nullptr;
+    }
+
+    if (name != nullptr) {
+        auto it = input_indices.find(name);
+        if (it == input_indices.end()) {
+            PyErr_Format(PyExc_KeyError, "'%s' is not a configured input name", name);
+            return nullptr;
+        }
+        return PyBool_FromLong(InputChanged(it->second));
+    }
+
+    // No name: return a bitmask with bit i set when input #i changed.
+    // Built as a hex string so contracts with more than 64 inputs still fit.
+    size_t count = changed_flags.size();
+    std::string hex((count + 3) / 4 + 1, '0');
+    for (size_t i = 0; i < count; ++i) {
+        if (InputChanged(i)) {
+            char& digit = hex[hex.size() - 1 - i / 4];
+            int value = (digit <= '9' ? digit - '0' : digit - 'a' + 10) | (1 << (i % 4));
+            digit = static_cast<char>(value < 10 ? '0' + value : 'a' + value - 10);
+        }
+    }
+    return PyLong_FromString(hex.c_str(), nullptr, 16);
+}
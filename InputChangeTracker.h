@@ -0,0 +1,30 @@
+#pragma once
+#include <Python.h>
+#include "json.hpp"
+#include <string>
+#include <vector>
+
+// Location of one configured input inside the inargs block, in doubles.
+struct InputSlice {
+    size_t offset;
+    size_t length;
+};
+
+// Builds the name -> index table from the config and enables tracking when
+// "track_changes" is set or any output declares its own "function". Also
+// forgets the previous block, so the first calculation of every realization
+// reports all inputs as changed.
+void ResetInputChangeTracking(const nlohmann::json& config);
+
+// True when change tracking is active for the loaded config.
+bool IsInputChangeTrackingEnabled();
+
+// Compares each slice of inargs with the same slice from the previous call and
+// remembers the current block for the next comparison.
+void UpdateInputChanges(const double* inargs, const std::vector<InputSlice>& slices);
+
+// True if input #index differs from the previous call (always true when tracking is off).
+bool InputChanged(size_t index);
+
+// Python-callable: gspy.changed(name=None)
+PyObject* PythonChanged(PyObject* self, PyObject* args);
@@ -0,0 +1,185 @@
+#ifdef _DEBUG
+    #undef _DEBUG
+    #include <Python.h>
+    #define _DEBUG
+#else
+    #include <Python.h>
+#endif
+
+#include "LazyInputManager.h"
+#include "Logger.h"
+#include <unordered_map>
+
+// gspy.LazyInputs: one instance per calculation call. Each input is built by the
+// materializer the first time the script reads it and cached for the rest of the call.
+struct LazyInputsObject {
+    PyObject_HEAD
+    double* inargs;             // nullptr once the call has ended
+    const InputSlice* slices;
+    Py_ssize_t count;
+    PyObject** values;          // Materialized inputs, nullptr until first access
+};
+
+static const nlohmann::json* lazy_inputs_config = nullptr;
+static InputMaterializer lazy_materializer = nullptr;
+static std::unordered_map<std::string, Py_ssize_t> lazy_input_indices;
+static PyObject* lazy_inputs_type = nullptr;
+static LazyInputsObject* current_lazy_inputs = nullptr;
+
+// Usage statistics for the whole run
+static std::vector<unsigned long long> lazy_access_counts;
+static unsigned long long lazy_call_count = 0;
+
+static PyObject* lazy_get(LazyInputsObject* self, Py_ssize_t index) {
+    if (self->inargs == nullptr) {
+        PyErr_SetString(PyExc_RuntimeError, "GSPy inputs are only available during the call that received them.");
+        return nullptr;
+    }
+    if (index < 0 || index >= self->count) {
+        PyErr_SetString(PyExc_IndexError, "input index out of range");
+        return nullptr;
+    }
+
+    if (self->values[index] == nullptr) {
+        const InputSlice& slice = self->slices[index];
+        self->values[index] = lazy_materializer((*lazy_inputs_config)[index], static_cast<size_t>(index), self->inargs + slice.offset);
+        if (self->values[index] == nullptr) return nullptr;
+        ++lazy_access_counts[index];
+    }
+    Py_INCREF(self->values[index]);
+    return self->values[index];
+}
+
+static PyObject* lazy_getattro(PyObject* self, PyObject* name) {
+    const char* key = PyUnicode_AsUTF8(name);
+    if (key != nullptr) {
+        auto it = lazy_input_indices.find(key);
+        if (it != lazy_input_indices.end()) {
+            return lazy_get((LazyInputsObject*)self, it->second);
+        }
+    }
+    return PyObject_GenericGetAttr(self, name);
+}
+
+static PyObject* lazy_subscript(PyObject* self, PyObject* key) {
+    if (PyUnicode_Check(key)) {
+        auto it = lazy_input_indices.find(PyUnicode_AsUTF8(key));
+        if (it == lazy_input_indices.end()) {
+            PyErr_SetObject(PyExc_KeyError, key);
+            return nullptr;
+        }
+        return lazy_get((LazyInputsObject*)self, it->second);
+    }
+
+    Py_ssize_t index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (index == -1 && PyErr_Occurred()) return nullptr;
+    if (index < 0) index += ((LazyInputsObject*)self)->count;
+    return lazy_get((LazyInputsObject*)self, index);
+}
+
+static Py_ssize_t lazy_length(PyObject* self) {
+    return ((LazyInputsObject*)self)->count;
+}
+
+static void lazy_dealloc(PyObject* self) {
+    LazyInputsObject* lazy = (LazyInputsObject*)self;
+    if (current_lazy_inputs == lazy) current_lazy_inputs = nullptr;
+    for (Py_ssize_t i = 0; i < lazy->count; ++i) {
+        Py_XDECREF(lazy->values[i]);
+    }
+    PyMem_Free(lazy->values);
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+static PyType_Slot lazy_inputs_slots[] = {
+    {Py_tp_dealloc, (void*)lazy_dealloc},
+    {Py_tp_getattro, (void*)lazy_getattro},
+    {Py_mp_subscript, (void*)lazy_subscript},
+    {Py_mp_length, (void*)lazy_length},
+    {Py_tp_doc, (void*)"GSPy inputs, built on first access by name (attribute or key) or position."},
+    {0, nullptr}
+};
+
+static PyType_Spec lazy_inputs_spec = {
+    "gspy.LazyInputs",
+    sizeof(LazyInputsObject),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    lazy_inputs_slots
+};
+
+bool InitLazyInputs(const nlohmann::json& inputs_config, InputMaterializer materializer, std::string& errorMessage) {
+    lazy_inputs_config = &inputs_config;
+    lazy_materializer = materializer;
+
+    lazy_input_indices.clear();
+    for (size_t i = 0; i < inputs_config.size(); ++i) {
+        lazy_input_indices[inputs_config[i].value("name", "")] = static_cast<Py_ssize_t>(i);
+    }
+    lazy_access_counts.assign(inputs_config.size(), 0);
+    lazy_call_count = 0;
+
+    if (lazy_inputs_type == nullptr) {
+        lazy_inputs_type = PyType_FromSpec(&lazy_inputs_spec);
+        if (lazy_inputs_type == nullptr) {
+            PyErr_Print();
+            errorMessage = "Error: Could not create the gspy.LazyInputs type.";
+            LogError(errorMessage);
+            return false;
+        }
+    }
+    GSPY_LOG_DEBUG("Lazy input mode enabled for " + std::to_string(inputs_config.size()) + " input(s).");
+    return true;
+}
+
+PyObject* CreateLazyInputs(double* inargs, const std::vector<InputSlice>& slices) {
+    PyTypeObject* type = (PyTypeObject*)lazy_inputs_type;
+    LazyInputsObject* self = (LazyInputsObject*)type->tp_alloc(type, 0);
+    if (self == nullptr) return nullptr;
+
+    self->inargs = inargs;
+    self->slices = slices.data();
+    self->count = static_cast<Py_ssize_t>(slices.size());
+    self->values = (PyObject**)PyMem_Calloc(slices.size() ? slices.size() : 1, sizeof(PyObject*));
+    if (self->values == nullptr) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+
+    current_lazy_inputs = self;
+    ++lazy_call_count;
+    return (PyObject*)self;
+}
+
+void EndLazyInputsCall() {
+    if (current_lazy_inputs != nullptr) {
+        current_lazy_inputs->inargs = nullptr;
+        current_lazy_inputs = nullptr;
+    }
+}
+
+void LogLazyInputUsage() {
+    if (lazy_inputs_config == nullptr || lazy_call_count == 0) return;
+
+    size_t unused = 0;
+    for (size_t i = 0; i < lazy_access_counts.size(); ++i) {
+        std::string name = (*lazy_inputs_config)[i].value("name", "#" + std::to_string(i));
+        GSPY_LOG_DEBUG("Lazy input '" + name + "' read in " + std::to_string(lazy_access_counts[i]) +
+                       " of " + std::to_string(lazy_call_count) + " call(s).");
+        if (lazy_access_counts[i] == 0) {
+            GSPY_LOG_INFO("Input '" + name + "' was never read by the script during this run.");
+            ++unused;
+        }
+    }
+    GSPY_LOG_INFO("Lazy inputs: " + std::to_string(lazy_access_counts.size() - unused) + " read, " +
+                  std::to_string(unused) + " never read over " + std::to_string(lazy_call_count) + " call(s).");
+}
+
+void ReleaseLazyInputs() {
+    EndLazyInputsCall();
+    Py_XDECREF(lazy_inputs_type);
+    lazy_inputs_type = nullptr;
+    lazy_inputs_config = nullptr;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <Python.h>
+#include "json.hpp"
+#include <string>
+#include <vector>
+#include "InputChangeTracker.h"
+
+// Builds the Python object for input #index whose data starts at input_start.
+typedef PyObject* (*InputMaterializer)(const nlohmann::json& input, size_t index, double* input_start);
+
+// Readies the gspy.LazyInputs type and the name -> index table for the configured inputs.
+bool InitLazyInputs(const nlohmann::json& inputs_config, InputMaterializer materializer, std::string& errorMessage);
+
+// Creates the lazy argument object for one calculation call (new reference).
+// Nothing is materialized until the script reads an input.
+PyObject* CreateLazyInputs(double* inargs, const std::vector<InputSlice>& slices);
+
+// Detaches the object created for the current call so stale reads raise instead of
+// returning data GoldSim has since overwritten.
+void EndLazyInputsCall();
+
+// Logs how often each input was actually read, to help spot dead inputs.
+void LogLazyInputUsage();
+
+// Releases the type's cached state. Call before Py_Finalize.
+void ReleaseLazyInputs();
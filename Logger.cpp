@@ -1,4 +1,5 @@
 #include "Logger.h"
+#include "BinaryLog.h"
 #include "GSPy.h"
 #include <fstream>
 #include <chrono>
@@ -7,6 +8,10 @@
 #include <atomic>
 #include <mutex>
 #include <iostream>
+#include <thread>
+#include <condition_variable>
+#include <memory>
+#include <cstring>
 
 // This static variable holds the connection to our log file
 static std::ofstream log_file;
@@ -79,9 +84,247 @@ void WriteLogHeader() {
     }
 }
 
-inline bool ShouldLog(LogLevel level) {
-    // Fast-path filtering using atomic read with memory_order_relaxed for performance
-    return level <= current_log_level_atomic.load(std::memory_order_relaxed);
+// =================================================================
+// Asynchronous backend
+// =================================================================
+
+// One pre-sized ring slot. A record longer than one slot continues in the slots after it;
+// the producer claims all of them at once, so records never interleave.
+struct alignas(64) LogSlot {
+    std::atomic<size_t> sequence;   // Vyukov sequence: position + 1 when published
+    long long timestamp;            // system_clock ticks, taken by the producer
+    unsigned short length;
+    unsigned char level;
+    unsigned char flags;
+    char text[232];
+};
+static_assert(sizeof(LogSlot) == 256, "LogSlot should be exactly four cache lines");
+
+static const unsigned char slot_continued = 1;  // Text continues in the next slot
+static const unsigned char slot_raw = 2;        // LogAlways: no timestamp prefix
+
+// C++14 operator new only guarantees 16-byte alignment, so the slots are placed in a
+// buffer with room to round up to the 64-byte boundary
+static std::unique_ptr<char[]> ring_storage;
+static LogSlot* ring_slots = nullptr;
+static size_t ring_capacity = 0;
+static LogOverflow ring_overflow = LogOverflow::Drop;
+alignas(64) static std::atomic<size_t> ring_head{0};     // Next position producers claim
+alignas(64) static std::atomic<size_t> dropped_records{0};
+
+static std::atomic<bool> async_enabled{false};
+static std::atomic<int> active_producers{0};
+
+// Writer thread state. The mutex only guards sleeping and flush hand-offs, never a push.
+static std::thread* writer_thread = nullptr;  // Never destroyed while joinable, even at process exit
+static std::mutex writer_mutex;
+static std::condition_variable writer_wakeup;
+static std::condition_variable flush_done;
+static bool writer_stop = false;
+static size_t flush_target = 0;     // Flush requested up to this position
+static size_t flushed_position = 0; // Everything before this is written and flushed
+
+// Claims slots for message and publishes them. Returns false if the record was dropped.
+static bool push_record(const std::string& message, LogLevel level, unsigned char flags) {
+    const size_t text_size = sizeof(LogSlot::text);
+    size_t length = message.size();
+    size_t needed = length == 0 ? 1 : (length + text_size - 1) / text_size;
+    if (needed > ring_capacity) {
+        needed = ring_capacity;
+        length = needed * text_size;
+    }
+    long long now = std::chrono::system_clock::now().time_since_epoch().count();
+
+    size_t pos = ring_head.load(std::memory_order_relaxed);
+    for (;;) {
+        // The writer frees slots in order, so if the last slot is free all of them are
+        size_t last = pos + needed - 1;
+        size_t seq = ring_slots[last & (ring_capacity - 1)].sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - last);
+        if (diff == 0) {
+            if (ring_head.compare_exchange_weak(pos, pos + needed, std::memory_order_relaxed)) break;
+        }
+        else if (diff < 0) {
+            if (ring_overflow == LogOverflow::Drop && level != LOG_ERROR) {
+                dropped_records.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            writer_wakeup.notify_one();
+            std::this_thread::yield();
+            pos = ring_head.load(std::memory_order_relaxed);
+        }
+        else {
+            pos = ring_head.load(std::memory_order_relaxed);
+        }
+    }
+
+    for (size_t i = 0; i < needed; ++i) {
+        LogSlot& slot = ring_slots[(pos + i) & (ring_capacity - 1)];
+        size_t offset = i * text_size;
+        size_t chunk = length - offset < text_size ? length - offset : text_size;
+        memcpy(slot.text, message.data() + offset, chunk);
+        slot.length = static_cast<unsigned short>(chunk);
+        slot.level = static_cast<unsigned char>(level);
+        slot.flags = flags | (i + 1 < needed ? slot_continued : 0);
+        slot.timestamp = now;
+        slot.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    return true;
+}
+
+// Routes a record to the ring if the asynchronous backend is on. The producer count lets
+// StopAsyncLogger wait for pushes that started before it switched the backend off.
+static bool try_log_async(const std::string& message, LogLevel level, unsigned char flags) {
+    if (!async_enabled.load(std::memory_order_acquire)) return false;
+    active_producers.fetch_add(1, std::memory_order_acq_rel);
+    bool queued = async_enabled.load(std::memory_order_acquire);
+    if (queued) push_record(message, level, flags);
+    active_producers.fetch_sub(1, std::memory_order_acq_rel);
+    if (queued && (level == LOG_ERROR || (flags & slot_raw))) FlushLog();
+    return queued;
+}
+
+// Appends "YYYY-MM-DD HH:MM:SS - ", formatting the date only when the second changes
+static void append_timestamp(std::string& out, long long ticks) {
+    static time_t cached_second = -1;
+    static char cached_text[32];
+    auto when = std::chrono::system_clock::time_point(std::chrono::system_clock::duration(ticks));
+    time_t second = std::chrono::system_clock::to_time_t(when);
+    if (second != cached_second) {
+        tm buf;
+        localtime_s(&buf, &second);
+        strftime(cached_text, sizeof(cached_text), "%Y-%m-%d %X - ", &buf);
+        cached_second = second;
+    }
+    out += cached_text;
+}
+
+static void write_batch(const std::string& batch, bool flush) {
+    std::lock_guard<std::mutex> lock(log_mutex);
+    if (fallback_to_stderr) {
+        std::cerr.write(batch.data(), batch.size());
+        if (flush) std::cerr.flush();
+    } else if (log_file.is_open()) {
+        log_file.write(batch.data(), batch.size());
+        if (flush) log_file.flush();
+    }
+}
+
+static void writer_loop() {
+    const size_t batch_limit = 1 << 16;
+    std::string batch;
+    std::string record;     // Text of a record spanning several slots
+    batch.reserve(batch_limit + 512);
+    size_t tail = 0;
+
+    for (;;) {
+        bool severe = false;
+        size_t start = tail;
+        while (batch.size() < batch_limit) {
+            LogSlot& slot = ring_slots[tail & (ring_capacity - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != tail + 1) break;
+            record.append(slot.text, slot.length);
+            if (!(slot.flags & slot_continued)) {
+                if (!(slot.flags & slot_raw)) append_timestamp(batch, slot.timestamp);
+                batch += record;
+                batch += '\n';
+                record.clear();
+                severe |= slot.level <= LOG_WARNING;
+            }
+            slot.sequence.store(tail + ring_capacity, std::memory_order_release);
+            ++tail;
+        }
+
+        size_t dropped = dropped_records.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            append_timestamp(batch, std::chrono::system_clock::now().time_since_epoch().count());
+            batch += "WARNING: " + std::to_string(dropped) + " log record(s) dropped because the log queue was full.\n";
+            severe = true;
+        }
+
+        std::unique_lock<std::mutex> lock(writer_mutex);
+        bool flush_wanted = flush_target > flushed_position;
+        if (!batch.empty() || flush_wanted) {
+            lock.unlock();
+            write_batch(batch, severe || flush_wanted);
+            batch.clear();
+            lock.lock();
+            if (record.empty()) {
+                flushed_position = tail;
+                flush_done.notify_all();
+            }
+        }
+
+        if (writer_stop && tail == ring_head.load(std::memory_order_acquire)) break;
+        if (tail == start) {
+            // Nothing published yet: sleep briefly, or just yield while a flush or stop waits
+            if (flush_target > flushed_position || writer_stop) {
+                lock.unlock();
+                std::this_thread::yield();
+            }
+            else {
+                writer_wakeup.wait_for(lock, std::chrono::milliseconds(2));
+            }
+        }
+    }
+
+    write_batch(std::string(), true);
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    flushed_position = tail;
+    flush_done.notify_all();
+}
+
+void StartAsyncLogger(size_t queue_size, LogOverflow overflow) {
+    if (async_enabled.load(std::memory_order_acquire)) return;
+
+    size_t capacity = 64;
+    while (capacity < queue_size) capacity <<= 1;
+    if (capacity != ring_capacity) {
+        ring_storage.reset(new char[capacity * sizeof(LogSlot) + alignof(LogSlot)]);
+        void* storage = ring_storage.get();
+        size_t space = capacity * sizeof(LogSlot) + alignof(LogSlot);
+        ring_slots = static_cast<LogSlot*>(std::align(alignof(LogSlot), capacity * sizeof(LogSlot), storage, space));
+        for (size_t i = 0; i < capacity; ++i) new (&ring_slots[i]) LogSlot;
+        ring_capacity = capacity;
+    }
+    for (size_t i = 0; i < capacity; ++i) ring_slots[i].sequence.store(i, std::memory_order_relaxed);
+    ring_head.store(0, std::memory_order_relaxed);
+    dropped_records.store(0, std::memory_order_relaxed);
+    ring_overflow = overflow;
+    writer_stop = false;
+    flush_target = 0;
+    flushed_position = 0;
+
+    writer_thread = new std::thread(writer_loop);
+    async_enabled.store(true, std::memory_order_release);
+}
+
+void StopAsyncLogger() {
+    if (!async_enabled.exchange(false, std::memory_order_acq_rel)) return;
+    while (active_producers.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        writer_stop = true;
+    }
+    writer_wakeup.notify_one();
+    writer_thread->join();
+    delete writer_thread;
+    writer_thread = nullptr;
+}
+
+bool IsAsyncLoggerRunning() {
+    return async_enabled.load(std::memory_order_acquire);
+}
+
+void FlushLog() {
+    FlushBinaryLog();
+    if (!async_enabled.load(std::memory_order_acquire)) return;
+    size_t target = ring_head.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(writer_mutex);
+    if (target > flush_target) flush_target = target;
+    writer_wakeup.notify_one();
+    flush_done.wait(lock, [target] { return flushed_position >= target; });
 }
 
 void Log(const std::string& message, LogLevel level) {
@@ -89,6 +332,13 @@ void Log(const std::string& message, LogLevel level) {
     if (!ShouldLog(level)) {
         return;
     }
+    // DEBUG detail goes to the binary log while it is open
+    if (level == LOG_DEBUG && WriteBinaryLogText(message)) {
+        return;
+    }
+    if (try_log_async(message, level, 0)) {
+        return;
+    }
     
     // Thread-safe operations using mutex - maintain thread safety during fallback operations
     std::lock_guard<std::mutex> lock(log_mutex);
@@ -138,6 +388,10 @@ void LogDebug(const std::string& message) {
 }
 
 void LogAlways(const std::string& message) {
+    if (try_log_async(message, LOG_ERROR, slot_raw)) {
+        return;
+    }
+
     // Thread-safe operations using mutex
     std::lock_guard<std::mutex> lock(log_mutex);
     
@@ -148,4 +402,20 @@ void LogAlways(const std::string& message) {
         log_file << message << '\n';
         log_file.flush();  // Always flush for critical diagnostic information
     }
+}
+bool TryLogAlways(const std::string& message) {
+    // Written synchronously: the writer thread may be unable to run. Wait at most ~100 ms
+    // for the log lock, since the thread that crashed may be the one holding it.
+    std::unique_lock<std::mutex> lock(log_mutex, std::try_to_lock);
+    for (int attempt = 0; !lock.owns_lock() && attempt < 100; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        lock.try_lock();
+    }
+    if (!lock.owns_lock() || fallback_to_stderr || !log_file.is_open()) {
+        std::cerr << message << std::endl;
+        return false;
+    }
+    log_file << message << '\n';
+    log_file.flush();
+    return true;
 }
\ No newline at end of file
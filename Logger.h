@@ -2,6 +2,7 @@
 #include <string>
 #include <atomic>
 #include <mutex>
+#include <cstddef>
 
 // Define logging levels
 enum LogLevel {
@@ -27,7 +28,26 @@ extern bool fallback_to_stderr;
 void SetLogLevelFromInt(int level);
 
 // Fast-path filtering function for performance optimization
-inline bool ShouldLog(LogLevel level);
+inline bool ShouldLog(LogLevel level) {
+    // Fast-path filtering using atomic read with memory_order_relaxed for performance
+    return level <= current_log_level_atomic.load(std::memory_order_relaxed);
+}
+
+// Highest level compiled into the DLL. Call sites above it are removed entirely by the
+// GSPY_LOG_* macros below; define GSPY_COMPILED_LOG_LEVEL=2 to strip every DEBUG site.
+#ifndef GSPY_COMPILED_LOG_LEVEL
+    #define GSPY_COMPILED_LOG_LEVEL 3
+#endif
+
+// Deferred logging: the message expression (string concatenation, std::to_string, ...) is
+// only evaluated once the level has passed both the compile-time and the runtime check.
+#define GSPY_LOG_AT(level, call) \
+    do { if ((level) <= GSPY_COMPILED_LOG_LEVEL && ShouldLog(level)) { call; } } while (0)
+
+#define GSPY_LOG(level, message)    GSPY_LOG_AT(level, Log(message, level))
+#define GSPY_LOG_WARNING(message)   GSPY_LOG_AT(LOG_WARNING, LogWarning(message))
+#define GSPY_LOG_INFO(message)      GSPY_LOG_AT(LOG_INFO, LogInfo(message))
+#define GSPY_LOG_DEBUG(message)     GSPY_LOG_AT(LOG_DEBUG, LogDebug(message))
 
 // Prepares the log file for writing (clears any old content)
 void InitLogger(const std::string& filename, LogLevel level = LOG_INFO);
@@ -47,3 +67,26 @@ void LogDebug(const std::string& message);
 // Logs a message regardless of log_level setting (bypasses filtering)
 // Used for critical diagnostic information that must always be written
 void LogAlways(const std::string& message);
+
+// LogAlways for crash handlers: writes directly to the file, bypassing the asynchronous queue,
+// and falls back to stderr instead of blocking if the log lock cannot be taken. Returns false
+// if the message did not reach the log file.
+bool TryLogAlways(const std::string& message);
+
+// What the asynchronous backend does when its ring buffer is full: drop the record (and
+// count it) or block the caller until the writer thread makes room. ERROR records always block.
+enum class LogOverflow { Drop, Block };
+
+// Switches logging to the asynchronous backend. Callers copy each record into a pre-sized
+// slot of a lock-free ring buffer (queue_size slots, rounded up to a power of two) and a
+// writer thread formats timestamps and writes in batches.
+void StartAsyncLogger(size_t queue_size, LogOverflow overflow);
+
+// Writes every queued record, stops the writer thread and returns to synchronous logging.
+void StopAsyncLogger();
+
+// True while the asynchronous backend is active
+bool IsAsyncLoggerRunning();
+
+// Blocks until every record logged so far is written and flushed (asynchronous queue and binary log)
+void FlushLog();
@@ -12,9 +12,28 @@
 
 #include "LookupTableManager.h"
 #include "Logger.h"
+#include "BinaryLog.h"
+#include "TableTranspose.h"
+#include "TableInterpolation.h"
 #include <vector>
+#include <cstdint>
+#include <unordered_map>
 
 
+// Initialize NumPy API, but only once.
+static bool ensure_numpy() {
+    static bool numpy_initialized = false;
+    if (!numpy_initialized) {
+        if (_import_array() < 0) {
+            LogError("Error: Could not initialize NumPy C-API in LookupTableManager.");
+            PyErr_Print();
+            return false;
+        }
+        numpy_initialized = true;
+    }
+    return true;
+}
+
 // Helper function to safely get a NumPy array from the Python dictionary
 static PyArrayObject* get_numpy_array(PyObject* py_dict, const char* key, std::string& errorMessage) {
     PyObject* py_item = PyDict_GetItemString(py_dict, key);
@@ -25,19 +44,38 @@ static PyArrayObject* get_numpy_array(PyObject* py_dict, const char* key, std::s
     return (PyArrayObject*)PyArray_FROM_OTF(py_item, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
 }
 
-bool MarshalPythonLookupTableToGoldSim(PyObject* py_object, const nlohmann::json& config, double*& current_outarg_pointer, std::string& errorMessage) {
-    Log("--- LookupTableManager: Marshalling Python Lookup Table to GoldSim ---");
+// Copies a (rows, cols, layers) array into dst in GoldSim's layer-major order, dst[layer][row][col].
+// The strides decide how: layer-major arrays (e.g. np.moveaxis of a C-ordered (layers, rows, cols)
+// array) are one memcpy, C-ordered arrays are a single (rows*cols) x layers transpose, and
+// Fortran-ordered arrays are one cols x rows transpose per layer.
+static void WriteLayerMajor(PyArrayObject* data, npy_intp num_rows, npy_intp num_cols, npy_intp num_layers, double* dst) {
+    const npy_intp item = sizeof(double);
+    npy_intp* strides = PyArray_STRIDES(data);
+    npy_intp layer_size = num_rows * num_cols;
 
-    // Initialize NumPy API if it hasn't been already
-    static bool numpy_initialized = false;
-    if (!numpy_initialized) {
-        if (_import_array() < 0) {
-            errorMessage = "Error: Could not initialize NumPy C-API in LookupTableManager.";
-            LogError(errorMessage); PyErr_Print(); return false;
+    if (strides[2] == layer_size * item && strides[0] == num_cols * item && strides[1] == item) {
+        GSPY_LOG_DEBUG("  3D table data is already layer-major; copying directly.");
+        memcpy(dst, PyArray_DATA(data), layer_size * num_layers * item);
+    }
+    else if (PyArray_IS_C_CONTIGUOUS(data)) {
+        TransposeMatrix((const double*)PyArray_DATA(data), dst, layer_size, num_layers);
+    }
+    else if (PyArray_IS_F_CONTIGUOUS(data)) {
+        GSPY_LOG_DEBUG("  3D table data is Fortran-ordered; transposing each layer.");
+        const double* src = (const double*)PyArray_DATA(data);
+        for (npy_intp layer = 0; layer < num_layers; ++layer) {
+            TransposeMatrix(src + layer * layer_size, dst + layer * layer_size, num_cols, num_rows);
         }
-        numpy_initialized = true;
     }
+    else {
+        PyArrayObject* contiguous = (PyArrayObject*)PyArray_NewCopy(data, NPY_CORDER);
+        TransposeMatrix((const double*)PyArray_DATA(contiguous), dst, layer_size, num_layers);
+        Py_DECREF(contiguous);
+    }
+}
 
+// Converts a table dictionary and writes the GoldSim Lookup Table sequence.
+static bool write_lookup_table(PyObject* py_object, double*& current_outarg_pointer, std::string& errorMessage) {
     if (!PyDict_Check(py_object)) {
         errorMessage = "Error: Python script was expected to return a dictionary for a Lookup Table output.";
         LogError(errorMessage); return false;
@@ -54,7 +92,7 @@ bool MarshalPythonLookupTableToGoldSim(PyObject* py_object, const nlohmann::json
     // Use a switch to handle 1D, 2D, or 3D cases
     switch (table_dim) {
     case 1: {
-        LogDebug("  Marshalling 1D Lookup Table.");
+        GSPY_LOG_DEBUG("  Marshalling 1D Lookup Table.");
         PyArrayObject* row_labels = get_numpy_array(py_object, "row_labels", errorMessage);
         PyArrayObject* data = get_numpy_array(py_object, "data", errorMessage);
         if (!row_labels || !data) { if (row_labels) Py_DECREF(row_labels); if (data) Py_DECREF(data); return false; }
@@ -74,7 +112,7 @@ bool MarshalPythonLookupTableToGoldSim(PyObject* py_object, const nlohmann::json
         break;
     }
     case 2: {
-        LogDebug("  Marshalling 2D Lookup Table.");
+        GSPY_LOG_DEBUG("  Marshalling 2D Lookup Table.");
         PyArrayObject* row_labels = get_numpy_array(py_object, "row_labels", errorMessage);
         PyArrayObject* col_labels = get_numpy_array(py_object, "col_labels", errorMessage);
         PyArrayObject* data = get_numpy_array(py_object, "data", errorMessage);
@@ -101,20 +139,31 @@ bool MarshalPythonLookupTableToGoldSim(PyObject* py_object, const nlohmann::json
         break;
     }
     case 3: {
-        LogDebug("  Marshalling 3D Lookup Table.");
+        GSPY_LOG_DEBUG("  Marshalling 3D Lookup Table.");
         PyArrayObject* row_labels = get_numpy_array(py_object, "row_labels", errorMessage);
         PyArrayObject* col_labels = get_numpy_array(py_object, "col_labels", errorMessage);
         PyArrayObject* layer_labels = get_numpy_array(py_object, "layer_labels", errorMessage);
-        PyArrayObject* data = get_numpy_array(py_object, "data", errorMessage);
+        // Data keeps its own memory order so layer-major and Fortran-ordered arrays avoid a copy
+        PyObject* py_data = PyDict_GetItemString(py_object, "data");
+        PyArrayObject* data = py_data ? (PyArrayObject*)PyArray_FROM_OTF(py_data, NPY_DOUBLE, NPY_ARRAY_ALIGNED) : nullptr;
+        if (!py_data) errorMessage = "Error: Python dictionary is missing required key: data";
         if (!row_labels || !col_labels || !layer_labels || !data) { /* Cleanup and return */ return false; }
 
         npy_intp num_rows = PyArray_SIZE(row_labels);
         npy_intp num_cols = PyArray_SIZE(col_labels);
         npy_intp num_layers = PyArray_SIZE(layer_labels);
-        npy_intp data_size = PyArray_SIZE(data);
 
-        LogDebug("  3D Table dimensions: " + std::to_string(num_rows) + " rows, " + 
-                 std::to_string(num_cols) + " cols, " + std::to_string(num_layers) + " layers");
+        GSPY_LOG_EVENT(Table3DDimensions, num_rows, num_cols, num_layers);
+
+        if (PyArray_NDIM(data) != 3 || PyArray_DIM(data, 0) != num_rows || PyArray_DIM(data, 1) != num_cols || PyArray_DIM(data, 2) != num_layers) {
+            errorMessage = "Error: 3D table 'data' must have shape (len(row_labels), len(col_labels), len(layer_labels)).";
+            LogError(errorMessage);
+            Py_DECREF(row_labels);
+            Py_DECREF(col_labels);
+            Py_DECREF(layer_labels);
+            Py_DECREF(data);
+            return false;
+        }
 
         // Write 3D table sequence to GoldSim buffer
         *current_outarg_pointer++ = 3.0; // Number of dimensions
@@ -129,18 +178,8 @@ bool MarshalPythonLookupTableToGoldSim(PyObject* py_object, const nlohmann::json
         current_outarg_pointer += num_layers;
 
         // GoldSim expects data in layer-major order: all rows/cols for layer 0, then all for layer 1, etc.
-        // Python NumPy array has shape (num_rows, num_cols, num_layers) with C-order (row-major)
-        // We need to reorder from (r,c,l) indexing to layer-major: data[layer][row][col]
-        double* data_ptr = (double*)PyArray_DATA(data);
-        for (npy_intp layer = 0; layer < num_layers; ++layer) {
-            for (npy_intp row = 0; row < num_rows; ++row) {
-                for (npy_intp col = 0; col < num_cols; ++col) {
-                    // Access NumPy array in (row, col, layer) order
-                    npy_intp index = row * num_cols * num_layers + col * num_layers + layer;
-                    *current_outarg_pointer++ = data_ptr[index];
-                }
-            }
-        }
+        WriteLayerMajor(data, num_rows, num_cols, num_layers, current_outarg_pointer);
+        current_outarg_pointer += num_rows * num_cols * num_layers;
 
         Py_DECREF(row_labels);
         Py_DECREF(col_labels);
@@ -155,4 +194,753 @@ bool MarshalPythonLookupTableToGoldSim(PyObject* py_object, const nlohmann::json
     }
 
     return true;
-}
\ No newline at end of file
+}
+
+// =================================================================
+// gspy.Table: a table already laid out in GoldSim order
+// =================================================================
+
+// The complete GoldSim sequence (dimension count, sizes, labels, values) lives in one
+// buffer built and validated at construction, so an output is a single memcpy.
+struct TableObject {
+    PyObject_HEAD
+    long table_dim;
+    npy_intp sizes[3];
+    double* block;
+    npy_intp length;        // Doubles in block
+};
+
+static PyObject* table_type = nullptr;
+
+static const char* label_keys[] = { "row_labels", "col_labels", "layer_labels" };
+
+static double* table_labels(TableObject* table, long d) {
+    double* p = table->block + 1 + table->table_dim;
+    for (long i = 0; i < d; ++i) p += table->sizes[i];
+    return p;
+}
+
+// Read-only label views and a writable data view over the block. Each access returns a new
+// view whose base is the table, which keeps the block alive. The table holds no reference
+// back to its views: that would be a cycle the non-GC type could never free.
+static PyObject* table_view(TableObject* table, int index) {
+    npy_intp dims[3] = { table->sizes[0], table->sizes[1], table->sizes[2] };
+    npy_intp strides[3];
+    int ndim = 1;
+    int flags = NPY_ARRAY_ALIGNED;
+    double* ptr;
+    if (index < 3) {
+        ptr = table_labels(table, index);
+        dims[0] = table->sizes[index];
+        strides[0] = sizeof(double);
+    }
+    else {
+        ptr = table_labels(table, table->table_dim);
+        ndim = table->table_dim;
+        flags |= NPY_ARRAY_WRITEABLE;
+        // 2D values are row-major; 3D values are layer-major and viewed as data[row, col, layer]
+        strides[ndim - 1] = sizeof(double);
+        if (ndim >= 2) strides[0] = dims[1] * sizeof(double);
+        if (ndim == 3) {
+            strides[1] = sizeof(double);
+            strides[2] = dims[0] * dims[1] * sizeof(double);
+        }
+    }
+    PyObject* view = PyArray_New(&PyArray_Type, ndim, dims, NPY_FLOAT64, strides, ptr, 0, flags, nullptr);
+    if (view == nullptr) return nullptr;
+    Py_INCREF(table);
+    PyArray_SetBaseObject((PyArrayObject*)view, (PyObject*)table); // Steals reference to table
+    return view;
+}
+
+static PyObject* table_get_table_dim(PyObject* self, void*) {
+    return PyLong_FromLong(((TableObject*)self)->table_dim);
+}
+
+// Labels of dimension (intptr_t)closure, or None if the table has fewer dimensions
+static PyObject* table_get_labels(PyObject* self, void* closure) {
+    TableObject* table = (TableObject*)self;
+    int d = static_cast<int>((intptr_t)closure);
+    if (d >= table->table_dim) Py_RETURN_NONE;
+    return table_view(table, d);
+}
+
+static PyObject* table_get_data(PyObject* self, void*) {
+    return table_view((TableObject*)self, 3);
+}
+
+static PyGetSetDef table_getset[] = {
+    {"table_dim", table_get_table_dim, nullptr, "Number of dimensions (1, 2 or 3)", nullptr},
+    {"row_labels", table_get_labels, nullptr, "Row labels (read-only)", (void*)0},
+    {"col_labels", table_get_labels, nullptr, "Column labels (read-only), or None for 1D tables", (void*)1},
+    {"layer_labels", table_get_labels, nullptr, "Layer labels (read-only), or None for 1D/2D tables", (void*)2},
+    {"data", table_get_data, nullptr, "Values indexed [row], [row, col] or [row, col, layer]", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+// Mapping interface with the keys of the table dictionary format, as present for the dimension
+static int table_contains(PyObject* self, PyObject* key) {
+    if (!PyUnicode_Check(key)) return 0;
+    if (PyUnicode_CompareWithASCIIString(key, "table_dim") == 0 || PyUnicode_CompareWithASCIIString(key, "data") == 0) return 1;
+    for (long d = 0; d < ((TableObject*)self)->table_dim; ++d) {
+        if (PyUnicode_CompareWithASCIIString(key, label_keys[d]) == 0) return 1;
+    }
+    return 0;
+}
+
+static PyObject* table_subscript(PyObject* self, PyObject* key) {
+    if (table_contains(self, key)) {
+        return PyObject_GenericGetAttr(self, key);
+    }
+    PyErr_SetObject(PyExc_KeyError, key);
+    return nullptr;
+}
+
+static Py_ssize_t table_length(PyObject* self) {
+    return 2 + ((TableObject*)self)->table_dim;
+}
+
+static PyObject* table_keys_method(PyObject* self, PyObject*) {
+    PyObject* keys = Py_BuildValue("[s]", "table_dim");
+    for (long d = 0; keys != nullptr && d < ((TableObject*)self)->table_dim; ++d) {
+        PyObject* key = PyUnicode_FromString(label_keys[d]);
+        PyList_Append(keys, key);
+        Py_DECREF(key);
+    }
+    if (keys == nullptr) return nullptr;
+    PyObject* key = PyUnicode_FromString("data");
+    PyList_Append(keys, key);
+    Py_DECREF(key);
+    return keys;
+}
+
+static PyObject* table_get_method(PyObject* self, PyObject* args) {
+    PyObject* key;
+    PyObject* default_value = Py_None;
+    if (!PyArg_ParseTuple(args, "O|O", &key, &default_value)) return nullptr;
+    if (table_contains(self, key)) return table_subscript(self, key);
+    Py_INCREF(default_value);
+    return default_value;
+}
+
+// values() and items() as lists, in keys() order
+static PyObject* table_mapping_list(PyObject* self, bool with_keys) {
+    PyObject* keys = table_keys_method(self, nullptr);
+    if (keys == nullptr) return nullptr;
+    Py_ssize_t count = PyList_GET_SIZE(keys);
+    PyObject* list = PyList_New(count);
+    for (Py_ssize_t i = 0; list != nullptr && i < count; ++i) {
+        PyObject* key = PyList_GET_ITEM(keys, i);
+        PyObject* value = PyObject_GenericGetAttr(self, key);
+        PyObject* entry = value != nullptr && with_keys ? PyTuple_Pack(2, key, value) : value;
+        if (with_keys) Py_XDECREF(value);
+        if (entry == nullptr) {
+            Py_CLEAR(list);
+            break;
+        }
+        PyList_SET_ITEM(list, i, entry);  // Steals reference to entry
+    }
+    Py_DECREF(keys);
+    return list;
+}
+
+static PyObject* table_values_method(PyObject* self, PyObject*) {
+    return table_mapping_list(self, false);
+}
+
+static PyObject* table_items_method(PyObject* self, PyObject*) {
+    return table_mapping_list(self, true);
+}
+
+// Iterating a table yields its keys, as iterating the dictionary did
+static PyObject* table_iter(PyObject* self) {
+    PyObject* keys = table_keys_method(self, nullptr);
+    if (keys == nullptr) return nullptr;
+    PyObject* iter = PyObject_GetIter(keys);
+    Py_DECREF(keys);
+    return iter;
+}
+
+static PyMethodDef table_methods[] = {
+    {"keys", table_keys_method, METH_NOARGS, "Keys of the table dictionary format"},
+    {"values", table_values_method, METH_NOARGS, "Values in keys() order"},
+    {"items", table_items_method, METH_NOARGS, "(key, value) pairs in keys() order"},
+    {"get", table_get_method, METH_VARARGS, "Dictionary-style get(key, default=None)"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+static PyObject* table_repr(PyObject* self) {
+    TableObject* table = (TableObject*)self;
+    std::string shape;
+    for (long d = 0; d < table->table_dim; ++d) shape += (d ? ", " : "") + std::to_string(table->sizes[d]);
+    if (table->table_dim == 1) shape += ",";
+    return PyUnicode_FromFormat("gspy.Table(dim=%ld, shape=(%s))", table->table_dim, shape.c_str());
+}
+
+// Labels must be 1-D, non-empty and strictly increasing, as GoldSim requires
+static bool check_labels(PyArrayObject* labels, const char* name, std::string& errorMessage) {
+    if (PyArray_NDIM(labels) != 1 || PyArray_SIZE(labels) < 1) {
+        errorMessage = std::string(name) + " must be a non-empty 1-D array.";
+        return false;
+    }
+    const double* p = (const double*)PyArray_DATA(labels);
+    for (npy_intp i = 1; i < PyArray_SIZE(labels); ++i) {
+        if (!(p[i] > p[i - 1])) {
+            errorMessage = std::string(name) + " must be strictly increasing (index " + std::to_string(i) + ").";
+            return false;
+        }
+    }
+    return true;
+}
+
+// gspy.Table(row_labels[, col_labels[, layer_labels]], data)
+static PyObject* table_new(PyTypeObject* type, PyObject* args, PyObject* kwargs) {
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    if ((kwargs != nullptr && PyDict_Size(kwargs) > 0) || nargs < 2 || nargs > 4) {
+        PyErr_SetString(PyExc_TypeError, "gspy.Table(row_labels[, col_labels[, layer_labels]], data) takes 2 to 4 positional arguments.");
+        return nullptr;
+    }
+    if (!ensure_numpy()) return nullptr;
+
+    long table_dim = static_cast<long>(nargs - 1);
+    PyArrayObject* arrays[4] = {};
+    std::string errorMessage;
+    bool ok = true;
+    for (long d = 0; d < table_dim && ok; ++d) {
+        arrays[d] = (PyArrayObject*)PyArray_FROM_OTF(PyTuple_GET_ITEM(args, d), NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+        ok = arrays[d] != nullptr && check_labels(arrays[d], label_keys[d], errorMessage);
+    }
+    if (ok) {
+        // 3D data keeps its memory order; WriteLayerMajor picks the cheapest reorder
+        int requirements = table_dim == 3 ? NPY_ARRAY_ALIGNED : NPY_ARRAY_IN_ARRAY;
+        arrays[3] = (PyArrayObject*)PyArray_FROM_OTF(PyTuple_GET_ITEM(args, table_dim), NPY_DOUBLE, requirements);
+        ok = arrays[3] != nullptr;
+    }
+    if (ok) {
+        bool shape_ok = PyArray_NDIM(arrays[3]) == table_dim;
+        for (long d = 0; d < table_dim && shape_ok; ++d) shape_ok = PyArray_DIM(arrays[3], d) == PyArray_SIZE(arrays[d]);
+        if (!shape_ok) {
+            errorMessage = "data must have shape (len(row_labels)[, len(col_labels)[, len(layer_labels)]]).";
+            ok = false;
+        }
+    }
+
+    TableObject* table = nullptr;
+    if (ok) {
+        table = (TableObject*)type->tp_alloc(type, 0);
+        ok = table != nullptr;
+    }
+    if (ok) {
+        table->table_dim = table_dim;
+        table->length = 1 + table_dim + PyArray_SIZE(arrays[3]);
+        for (long d = 0; d < table_dim; ++d) {
+            table->sizes[d] = PyArray_SIZE(arrays[d]);
+            table->length += table->sizes[d];
+        }
+        table->block = (double*)PyMem_Malloc(table->length * sizeof(double));
+        if (table->block == nullptr) {
+            PyErr_NoMemory();
+            ok = false;
+        }
+    }
+    if (ok) {
+        double* p = table->block;
+        *p++ = static_cast<double>(table_dim);
+        for (long d = 0; d < table_dim; ++d) *p++ = static_cast<double>(table->sizes[d]);
+        for (long d = 0; d < table_dim; ++d) {
+            memcpy(p, PyArray_DATA(arrays[d]), table->sizes[d] * sizeof(double));
+            p += table->sizes[d];
+        }
+        if (table_dim == 3) {
+            WriteLayerMajor(arrays[3], table->sizes[0], table->sizes[1], table->sizes[2], p);
+        }
+        else {
+            memcpy(p, PyArray_DATA(arrays[3]), PyArray_NBYTES(arrays[3]));
+        }
+    }
+
+    for (PyArrayObject* array : arrays) Py_XDECREF(array);
+    if (!ok) {
+        if (!errorMessage.empty()) PyErr_SetString(PyExc_ValueError, errorMessage.c_str());
+        Py_XDECREF(table);
+        return nullptr;
+    }
+    return (PyObject*)table;
+}
+
+static void table_dealloc(PyObject* self) {
+    TableObject* table = (TableObject*)self;
+    PyMem_Free(table->block);
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+static PyType_Slot table_slots[] = {
+    {Py_tp_new, (void*)table_new},
+    {Py_tp_dealloc, (void*)table_dealloc},
+    {Py_tp_repr, (void*)table_repr},
+    {Py_tp_getset, (void*)table_getset},
+    {Py_tp_methods, (void*)table_methods},
+    {Py_mp_subscript, (void*)table_subscript},
+    {Py_mp_length, (void*)table_length},
+    {Py_sq_contains, (void*)table_contains},
+    {Py_tp_iter, (void*)table_iter},
+    {Py_tp_doc, (void*)"GoldSim lookup table: gspy.Table(row_labels[, col_labels[, layer_labels]], data)."},
+    {0, nullptr}
+};
+
+static PyType_Spec table_spec = {
+    "gspy.Table",
+    sizeof(TableObject),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    table_slots
+};
+
+// =================================================================
+// gspy.Interpolator: multilinear lookups in a gspy.Table
+// =================================================================
+
+// Interpolates straight from the table's GoldSim-ordered buffer, so the same gspy.Table can
+// be returned as an output. The last cell found on each axis is kept for the next call.
+struct InterpolatorObject {
+    PyObject_HEAD
+    PyObject* table;        // gspy.Table (owned)
+    size_t hints[3];
+};
+
+static PyObject* interpolator_type = nullptr;
+
+// gspy.Interpolator(table) or gspy.Interpolator(row_labels[, col_labels[, layer_labels]], data)
+static PyObject* interpolator_new(PyTypeObject* type, PyObject* args, PyObject* kwargs) {
+    PyObject* table;
+    if (PyTuple_GET_SIZE(args) == 1 && PyObject_TypeCheck(PyTuple_GET_ITEM(args, 0), (PyTypeObject*)table_type)) {
+        table = PyTuple_GET_ITEM(args, 0);
+        Py_INCREF(table);
+    }
+    else {
+        table = PyObject_Call(table_type, args, kwargs);
+        if (table == nullptr) return nullptr;
+    }
+
+    InterpolatorObject* self = (InterpolatorObject*)type->tp_alloc(type, 0);
+    if (self == nullptr) {
+        Py_DECREF(table);
+        return nullptr;
+    }
+    self->table = table;
+    return (PyObject*)self;
+}
+
+// interp(x[, y[, z]]): one coordinate per table dimension, each a float or an array.
+// Arrays must share one shape (size-1 arrays are broadcast); the result has that shape.
+static PyObject* interpolator_call(PyObject* self, PyObject* args, PyObject* kwargs) {
+    InterpolatorObject* interp = (InterpolatorObject*)self;
+    TableObject* table = (TableObject*)interp->table;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    if ((kwargs != nullptr && PyDict_Size(kwargs) > 0) || nargs != table->table_dim) {
+        PyErr_Format(PyExc_TypeError, "gspy.Interpolator for a %ldD table takes %ld positional coordinate(s).", table->table_dim, table->table_dim);
+        return nullptr;
+    }
+
+    // Scalar query: no arrays at all
+    double point[3];
+    const double* coords[3];
+    size_t coord_steps[3] = { 0, 0, 0 };
+    bool scalar = true;
+    for (Py_ssize_t d = 0; d < nargs && scalar; ++d) {
+        PyObject* item = PyTuple_GET_ITEM(args, d);
+        scalar = PyFloat_Check(item) || PyLong_Check(item);
+        if (scalar) {
+            point[d] = PyFloat_AsDouble(item);
+            if (point[d] == -1.0 && PyErr_Occurred()) return nullptr;
+            coords[d] = &point[d];
+        }
+    }
+    if (scalar) {
+        double result;
+        InterpolateTable(table->block, coords, coord_steps, 1, &result, interp->hints);
+        return PyFloat_FromDouble(result);
+    }
+
+    if (!ensure_numpy()) return nullptr;
+    PyArrayObject* arrays[3] = {};
+    PyArrayObject* shape_source = nullptr;
+    bool ok = true;
+    for (Py_ssize_t d = 0; d < nargs && ok; ++d) {
+        arrays[d] = (PyArrayObject*)PyArray_FROM_OTF(PyTuple_GET_ITEM(args, d), NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+        ok = arrays[d] != nullptr;
+        if (ok && (shape_source == nullptr || PyArray_SIZE(arrays[d]) > PyArray_SIZE(shape_source))) shape_source = arrays[d];
+    }
+    for (Py_ssize_t d = 0; d < nargs && ok; ++d) {
+        npy_intp size = PyArray_SIZE(arrays[d]);
+        if (size != 1 && !PyArray_SAMESHAPE(arrays[d], shape_source)) {
+            PyErr_SetString(PyExc_ValueError, "gspy.Interpolator coordinate arrays must have the same shape.");
+            ok = false;
+        }
+        coords[d] = (const double*)PyArray_DATA(arrays[d]);
+        coord_steps[d] = size == 1 ? 0 : 1;
+    }
+
+    PyObject* result = ok ? PyArray_SimpleNew(PyArray_NDIM(shape_source), PyArray_DIMS(shape_source), NPY_FLOAT64) : nullptr;
+    if (result != nullptr) {
+        size_t count = static_cast<size_t>(PyArray_SIZE(shape_source));
+        double* out = (double*)PyArray_DATA((PyArrayObject*)result);
+        size_t hints[3] = { interp->hints[0], interp->hints[1], interp->hints[2] };
+        Py_BEGIN_ALLOW_THREADS
+        InterpolateTable(table->block, coords, coord_steps, count, out, hints);
+        Py_END_ALLOW_THREADS
+        memcpy(interp->hints, hints, sizeof(hints));
+    }
+    for (PyArrayObject* array : arrays) Py_XDECREF(array);
+    return result;
+}
+
+static PyObject* interpolator_get_table(PyObject* self, void*) {
+    PyObject* table = ((InterpolatorObject*)self)->table;
+    Py_INCREF(table);
+    return table;
+}
+
+static PyGetSetDef interpolator_getset[] = {
+    {"table", interpolator_get_table, nullptr, "The gspy.Table being interpolated (can be returned as a table output)", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+static PyObject* interpolator_repr(PyObject* self) {
+    PyObject* table_repr_str = PyObject_Repr(((InterpolatorObject*)self)->table);
+    if (table_repr_str == nullptr) return nullptr;
+    PyObject* repr = PyUnicode_FromFormat("gspy.Interpolator(%U)", table_repr_str);
+    Py_DECREF(table_repr_str);
+    return repr;
+}
+
+static void interpolator_dealloc(PyObject* self) {
+    Py_XDECREF(((InterpolatorObject*)self)->table);
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+static PyType_Slot interpolator_slots[] = {
+    {Py_tp_new, (void*)interpolator_new},
+    {Py_tp_dealloc, (void*)interpolator_dealloc},
+    {Py_tp_call, (void*)interpolator_call},
+    {Py_tp_repr, (void*)interpolator_repr},
+    {Py_tp_getset, (void*)interpolator_getset},
+    {Py_tp_doc, (void*)"Multilinear table interpolation: gspy.Interpolator(table) or gspy.Interpolator(labels..., data), then interp(x[, y[, z]])."},
+    {0, nullptr}
+};
+
+static PyType_Spec interpolator_spec = {
+    "gspy.Interpolator",
+    sizeof(InterpolatorObject),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    interpolator_slots
+};
+
+bool AddTableTypes(PyObject* module) {
+    if (table_type == nullptr) {
+        table_type = PyType_FromSpec(&table_spec);
+        if (table_type == nullptr) return false;
+    }
+    if (interpolator_type == nullptr) {
+        interpolator_type = PyType_FromSpec(&interpolator_spec);
+        if (interpolator_type == nullptr) return false;
+    }
+    Py_INCREF(table_type);
+    if (PyModule_AddObject(module, "Table", table_type) != 0) return false;
+    Py_INCREF(interpolator_type);
+    return PyModule_AddObject(module, "Interpolator", interpolator_type) == 0;
+}
+
+// =================================================================
+// Unchanged table outputs
+// =================================================================
+
+// The table last written for one output, and what it was built from
+struct CachedTable {
+    std::vector<double> block;
+    PyObject* table = nullptr;  // gspy.Table written last (owned); used instead of block
+    PyObject* sources[5] = {};  // table_dim, row/col/layer labels and data (owned references)
+    bool hashed = false;
+    uint64_t hash = 0;
+};
+
+// Keyed by the output's config entry, which lives as long as the loaded config
+static std::unordered_map<const nlohmann::json*, CachedTable> table_cache;
+static PyObject* unchanged_type = nullptr;
+static PyObject* unchanged_sentinel = nullptr;
+
+static const char* table_keys[] = { "table_dim", "row_labels", "col_labels", "layer_labels", "data" };
+
+// 64-bit multiply-xorshift hash over whole doubles; fast enough to run on every call
+static uint64_t hash_words(const uint64_t* words, size_t count, uint64_t hash) {
+    for (size_t i = 0; i < count; ++i) {
+        hash ^= words[i];
+        hash *= 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+
+// Hashes the arrays' shapes and contents. Only float64 C-contiguous arrays qualify; anything
+// else returns false and is always re-marshalled.
+static bool hash_table_sources(PyObject* const* sources, uint64_t& hash) {
+    hash = 0xCBF29CE484222325ull;
+    for (int i = 1; i < 5; ++i) {
+        PyObject* item = sources[i];
+        if (item == nullptr) continue;
+        if (!PyArray_Check(item)) return false;
+        PyArrayObject* array = (PyArrayObject*)item;
+        if (PyArray_TYPE(array) != NPY_DOUBLE || !PyArray_IS_C_CONTIGUOUS(array)) return false;
+
+        uint64_t shape[NPY_MAXDIMS + 1] = { static_cast<uint64_t>(PyArray_NDIM(array)) };
+        for (int d = 0; d < PyArray_NDIM(array); ++d) shape[d + 1] = static_cast<uint64_t>(PyArray_DIM(array, d));
+        hash = hash_words(shape, PyArray_NDIM(array) + 1, hash);
+        hash = hash_words((const uint64_t*)PyArray_DATA(array), static_cast<size_t>(PyArray_SIZE(array)), hash);
+    }
+    long table_dim = sources[0] ? PyLong_AsLong(sources[0]) : -1;
+    if (table_dim == -1 && PyErr_Occurred()) PyErr_Clear();
+    hash = hash_words((const uint64_t*)&table_dim, 1, hash ^ sizeof(table_dim));
+    return true;
+}
+
+// True when the array's memory cannot change behind it: the array is read-only and either
+// owns its data or is a view whose base chain is made of read-only arrays ending in an array
+// that owns its data or in a bytes object. A read-only view of a writable array (arr.view()
+// with writeable=False, np.broadcast_to) still changes when its base does, so it is rejected.
+static bool is_immutable_array(PyObject* object) {
+    while (PyArray_Check(object)) {
+        PyArrayObject* array = (PyArrayObject*)object;
+        if (PyArray_ISWRITEABLE(array)) return false;
+        PyObject* base = PyArray_BASE(array);
+        if (PyArray_CHKFLAGS(array, NPY_ARRAY_OWNDATA)) return true;
+        // No owner and no base: a wrapper over borrowed memory (such as a view over inargs)
+        // whose contents can change under it.
+        if (base == nullptr) return false;
+        object = base;
+    }
+    return PyBytes_Check(object);
+}
+
+// True when every source is the object written last time and is an immutable array, so it
+// cannot have been modified in place since.
+static bool same_readonly_sources(const CachedTable& cached, PyObject* const* sources) {
+    for (int i = 1; i < 5; ++i) {
+        if (sources[i] != cached.sources[i]) return false;
+        if (sources[i] != nullptr && !is_immutable_array(sources[i])) return false;
+    }
+    return sources[0] == cached.sources[0] || (sources[0] && cached.sources[0] && PyObject_RichCompareBool(sources[0], cached.sources[0], Py_EQ) == 1);
+}
+
+static void remember_sources(CachedTable& cached, PyObject* const* sources) {
+    for (int i = 0; i < 5; ++i) {
+        Py_XINCREF(sources[i]);
+        Py_XDECREF(cached.sources[i]);
+        cached.sources[i] = sources[i];
+    }
+}
+
+static bool resend_cached_table(const CachedTable& cached, double*& current_outarg_pointer) {
+    if (cached.table != nullptr) {
+        const TableObject* table = (const TableObject*)cached.table;
+        memcpy(current_outarg_pointer, table->block, table->length * sizeof(double));
+        current_outarg_pointer += table->length;
+        return true;
+    }
+    memcpy(current_outarg_pointer, cached.block.data(), cached.block.size() * sizeof(double));
+    current_outarg_pointer += cached.block.size();
+    return true;
+}
+
+bool MarshalPythonLookupTableToGoldSim(PyObject* py_object, const nlohmann::json& config, double*& current_outarg_pointer, std::string& errorMessage) {
+    GSPY_LOG(LOG_INFO, "--- LookupTableManager: Marshalling Python Lookup Table to GoldSim ---");
+
+    // Initialize NumPy API if it hasn't been already
+    if (!ensure_numpy()) {
+        errorMessage = "Error: Could not initialize NumPy C-API in LookupTableManager.";
+        return false;
+    }
+
+    CachedTable& cached = table_cache[&config];
+
+    // The script says nothing changed: resend the previous block
+    if (py_object == unchanged_sentinel && unchanged_sentinel != nullptr) {
+        if (cached.block.empty() && cached.table == nullptr) {
+            errorMessage = "Error: gspy.unchanged was returned for table output '" + config.value("name", "") + "' before any table was written.";
+            LogError(errorMessage);
+            return false;
+        }
+        GSPY_LOG_DEBUG("  Table output unchanged (gspy.unchanged); resending cached block.");
+        return resend_cached_table(cached, current_outarg_pointer);
+    }
+
+    // Native table: already in GoldSim order
+    if (table_type != nullptr && PyObject_TypeCheck(py_object, (PyTypeObject*)table_type)) {
+        TableObject* table = (TableObject*)py_object;
+        long max_elements = config.value("max_elements", 1);
+        if (table->length > max_elements) {
+            errorMessage = "Error: Table output '" + config.value("name", "") + "' needs " + std::to_string(table->length) +
+                           " values but its 'max_elements' is " + std::to_string(max_elements) + ".";
+            LogError(errorMessage);
+            return false;
+        }
+        Py_INCREF(py_object);
+        Py_XDECREF(cached.table);
+        cached.table = py_object;
+        cached.block.clear();
+        return resend_cached_table(cached, current_outarg_pointer);
+    }
+    Py_CLEAR(cached.table);
+
+    PyObject* sources[5] = {};
+    if (PyDict_Check(py_object)) {
+        for (int i = 0; i < 5; ++i) sources[i] = PyDict_GetItemString(py_object, table_keys[i]);
+    }
+
+    // Same read-only arrays, or identical contents: skip conversion and reordering
+    uint64_t hash = 0;
+    bool hashed = false;
+    if (!cached.block.empty()) {
+        if (same_readonly_sources(cached, sources)) {
+            GSPY_LOG_DEBUG("  Table output built from the same read-only arrays; resending cached block.");
+            return resend_cached_table(cached, current_outarg_pointer);
+        }
+        hashed = hash_table_sources(sources, hash);
+        if (hashed && cached.hashed && hash == cached.hash) {
+            GSPY_LOG_DEBUG("  Table output contents unchanged; resending cached block.");
+            remember_sources(cached, sources);
+            return resend_cached_table(cached, current_outarg_pointer);
+        }
+    }
+    else {
+        hashed = hash_table_sources(sources, hash);
+    }
+
+    double* block_start = current_outarg_pointer;
+    if (!write_lookup_table(py_object, current_outarg_pointer, errorMessage)) {
+        cached.block.clear();
+        return false;
+    }
+    cached.block.assign(block_start, current_outarg_pointer);
+    cached.hashed = hashed;
+    cached.hash = hash;
+    remember_sources(cached, sources);
+    return true;
+}
+
+static PyObject* unchanged_repr(PyObject*) {
+    return PyUnicode_FromString("gspy.unchanged");
+}
+
+static PyType_Slot unchanged_slots[] = {
+    {Py_tp_repr, (void*)unchanged_repr},
+    {Py_tp_doc, (void*)"Return gspy.unchanged for a table output to resend the previous table."},
+    {0, nullptr}
+};
+
+static PyType_Spec unchanged_spec = {
+    "gspy.UnchangedType",
+    sizeof(PyObject),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    unchanged_slots
+};
+
+bool AddUnchangedSentinel(PyObject* module) {
+    if (unchanged_sentinel == nullptr) {
+        unchanged_type = PyType_FromSpec(&unchanged_spec);
+        if (unchanged_type == nullptr) return false;
+        unchanged_sentinel = PyType_GenericAlloc((PyTypeObject*)unchanged_type, 0);
+        if (unchanged_sentinel == nullptr) return false;
+    }
+    Py_INCREF(unchanged_sentinel);
+    return PyModule_AddObject(module, "unchanged", unchanged_sentinel) == 0;
+}
+
+void ReleaseLookupTableCache() {
+    for (auto& entry : table_cache) {
+        for (PyObject* source : entry.second.sources) Py_XDECREF(source);
+        Py_XDECREF(entry.second.table);
+    }
+    table_cache.clear();
+    Py_CLEAR(table_type);
+    Py_CLEAR(interpolator_type);
+    Py_CLEAR(unchanged_sentinel);
+    Py_CLEAR(unchanged_type);
+}
+
+// =================================================================
+// Lookup table inputs (GoldSim -> Python)
+// =================================================================
+
+long GetGoldSimLookupTableLength(const double* table_start) {
+    // Sequence: dimension count, one size per dimension, the labels, then the values
+    long table_dim = static_cast<long>(table_start[0]);
+    if (table_dim < 1 || table_dim > 3) return 1;
+    long length = 1 + table_dim;
+    long data_size = 1;
+    for (long d = 0; d < table_dim; ++d) {
+        long size = static_cast<long>(table_start[1 + d]);
+        length += size;
+        data_size *= size;
+    }
+    return length + data_size;
+}
+
+// 1-D float64 view of count doubles at ptr
+static PyObject* label_view(double* ptr, npy_intp count) {
+    return PyArray_SimpleNewFromData(1, &count, NPY_FLOAT64, ptr);
+}
+
+PyObject* MarshalGoldSimLookupTableToPython(double* table_start, const nlohmann::json& config) {
+    if (!ensure_numpy()) {
+        // We can't send an error here easily, so we'll return None and let the Python call fail.
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+    GSPY_LOG(LOG_INFO, "--- LookupTableManager: Marshalling GoldSim Lookup Table to Python ---");
+
+    long table_dim = static_cast<long>(table_start[0]);
+    if (table_dim < 1 || table_dim > 3) {
+        LogError("Error: Table input '" + config.value("name", "") + "' has invalid dimension count " + std::to_string(table_dim) + ".");
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+
+    npy_intp sizes[3] = { 0, 0, 0 };
+    for (long d = 0; d < table_dim; ++d) sizes[d] = static_cast<npy_intp>(table_start[1 + d]);
+    GSPY_LOG_EVENT(TableInput, table_dim, sizes[0], sizes[1], sizes[2]);
+
+    PyObject* py_dict = PyDict_New();
+    PyObject* py_dim = PyLong_FromLong(table_dim);
+    PyDict_SetItemString(py_dict, "table_dim", py_dim);
+    Py_DECREF(py_dim);
+
+    // Labels follow the sizes, one array per dimension, then the values
+    double* p = table_start + 1 + table_dim;
+    for (long d = 0; d < table_dim; ++d) {
+        PyObject* labels = label_view(p, sizes[d]);
+        PyDict_SetItemString(py_dict, label_keys[d], labels);
+        Py_DECREF(labels);
+        p += sizes[d];
+    }
+
+    PyObject* data;
+    if (table_dim == 3) {
+        // GoldSim stores 3D values layer by layer; a strided view presents them as
+        // data[row, col, layer] (the same indexing as table outputs) without a transposed copy.
+        npy_intp dims[3] = { sizes[0], sizes[1], sizes[2] };
+        npy_intp strides[3] = { sizes[1] * (npy_intp)sizeof(double), (npy_intp)sizeof(double), sizes[0] * sizes[1] * (npy_intp)sizeof(double) };
+        data = PyArray_New(&PyArray_Type, 3, dims, NPY_FLOAT64, strides, p, 0, NPY_ARRAY_WRITEABLE | NPY_ARRAY_ALIGNED, nullptr);
+    }
+    else {
+        data = PyArray_SimpleNewFromData(table_dim, sizes, NPY_FLOAT64, p);
+    }
+    PyDict_SetItemString(py_dict, "data", data);
+    Py_DECREF(data);
+    return py_dict;
+}
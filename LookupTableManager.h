@@ -3,5 +3,23 @@
 #include "json.hpp"
 #include <string>
 
-// Takes a Python dictionary and writes the GoldSim Lookup Table format to the output buffer.
-bool MarshalPythonLookupTableToGoldSim(PyObject* py_object, const nlohmann::json& config, double*& current_outarg_pointer, std::string& errorMessage);
\ No newline at end of file
+// Takes a Python dictionary or gspy.Table and writes the GoldSim Lookup Table format to the output buffer.
+// The block written for each output is remembered: if the script returns the same read-only
+// arrays, arrays with identical contents, or gspy.unchanged, the block is copied again as is.
+bool MarshalPythonLookupTableToGoldSim(PyObject* py_object, const nlohmann::json& config, double*& current_outarg_pointer, std::string& errorMessage);
+
+// Registers the gspy.Table and gspy.Interpolator types on the gspy module.
+bool AddTableTypes(PyObject* module);
+
+// Registers gspy.unchanged on the gspy module.
+bool AddUnchangedSentinel(PyObject* module);
+
+// Releases the cached table blocks and gspy.unchanged. Call before Py_Finalize.
+void ReleaseLookupTableCache();
+
+// Returns how many doubles the GoldSim Lookup Table sequence starting at table_start occupies.
+long GetGoldSimLookupTableLength(const double* table_start);
+
+// Marshals a GoldSim Lookup Table input INTO a Python dictionary of zero-copy views:
+// "table_dim", "row_labels", "col_labels", "layer_labels" and "data" (as present for the dimension).
+PyObject* MarshalGoldSimLookupTableToPython(double* table_start, const nlohmann::json& config);
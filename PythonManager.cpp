@@ -15,14 +15,20 @@
 #include "GSPY_Error.h"
 #include <fstream>
 #include <vector>
+#include <map>
+#include <unordered_map>
 #include <chrono>
 #include <iomanip>
 #include <sstream>
 #include "json.hpp"
 #include "Logger.h"
+#include "FlightRecorder.h"
 #include "TimeSeriesManager.h"
 #include "ConfigManager.h"
 #include "LookupTableManager.h"
+#include "SharedDataManager.h"
+#include "InputChangeTracker.h"
+#include "LazyInputManager.h"
 
 using json = nlohmann::json;
 
@@ -30,6 +36,52 @@ static json config;
 static PyObject* pModule = nullptr;
 static PyObject* pFunc = nullptr;
 
+// Where each input was found in inargs during the most recent marshalling pass
+static std::vector<InputSlice> input_slices;
+
+// Per-output evaluation nodes, used when outputs declare their own "function".
+// Each node remembers the block it last wrote so unaffected outputs can be replayed.
+struct OutputNode {
+    PyObject* func = nullptr;          // nullptr for outputs read from a "source" file
+    std::vector<size_t> dependencies; // Input indices from "depends_on"
+    bool depends_on_all = true;       // No "depends_on" key: recompute on any change
+    std::vector<double> last_value;
+};
+static std::vector<OutputNode> output_nodes;
+
+// How inputs are presented to the Python function ("input_mode" in the config)
+enum class InputMode {
+    Tuple,          // One positional argument per input (default)
+    PackedScalars,  // All scalars as one read-only float64 array, then the other inputs
+    Record,         // Leading fixed-size inputs as one structured record, then the rest
+    Lazy,           // One LazyInputs object that builds each input on first access
+    Keywords        // Keyword arguments named after each input
+};
+static InputMode input_mode = InputMode::Tuple;
+
+// Packed-scalar layout, precomputed from the config. When every scalar sits at a
+// fixed, consecutive position in inargs the array is a zero-copy view; otherwise
+// the scalars are gathered into packed_scalar_buffer.
+static std::vector<std::string> packed_scalar_names;
+static long packed_scalar_offset = -1;
+static std::vector<double> packed_scalar_buffer;
+
+// Record layout: the leading inputs that precede any time series become named fields of
+// one structured dtype, built once. The record view is rebuilt only if inargs moves.
+static size_t record_field_count = 0;
+static PyArray_Descr* record_descr = nullptr;
+static PyObject* record_view = nullptr;
+static double* record_view_data = nullptr;
+
+// Interned input/output names, created once so keyword arguments and dict results
+// are matched by pointer comparison instead of building and hashing strings per call
+static std::vector<PyObject*> input_name_keys;
+static std::vector<PyObject*> output_name_keys;
+static PyObject* empty_args = nullptr;
+
+// Calculation calls so far, numbering the flight recorder's phase timings
+static unsigned long long calculation_count = 0;
+
 // =================================================================
 // Python-Callable Logging Function
 // =================================================================
@@ -37,38 +89,284 @@ static PyObject* pFunc = nullptr;
 // Global pointer to store error message for GoldSim (static - internal use only)
 static std::string* g_python_error_message = nullptr;
 
-// Python-callable logging function (static - internal use only)
-static PyObject* PythonLog(PyObject* self, PyObject* args) {
-    const char* message;
-    int level = 2; // Default to INFO level
-    
-    // Parse arguments: message (required), level (optional)
-    if (!PyArg_ParseTuple(args, "s|i", &message, &level)) {
-        return nullptr;
+// gspy.log throttling for scripts that log from per-step code. Both only see messages
+// that pass the log level, and ERROR messages are never throttled.
+static int log_rate_limit = 0;                      // "log_rate_limit": messages per call site per second, 0 = unlimited
+static unsigned long long log_sample_every = 1;     // "log_sample_every": INFO/DEBUG only in every Nth calculation
+
+// A gspy.log call site: the calling code object and line. Accessed with the GIL held.
+struct LogCallSite {
+    PyObject* code;     // Strong reference, released by release_log_sites()
+    int line;
+    bool operator==(const LogCallSite& other) const { return code == other.code && line == other.line; }
+};
+struct LogCallSiteHash {
+    size_t operator()(const LogCallSite& site) const {
+        return std::hash<const void*>()(site.code) ^ (static_cast<size_t>(site.line) * 0x9E3779B9u);
     }
-    
-    // Call the appropriate logging function based on level
+};
+struct LogSiteWindow {
+    long long second = -1;              // steady_clock second the count belongs to
+    int count = 0;
+    unsigned long long suppressed = 0;  // Not yet reported
+    int level = LOG_INFO;
+    std::string where;                  // "script.py:42", built once
+};
+static std::unordered_map<LogCallSite, LogSiteWindow, LogCallSiteHash> log_sites;
+
+static void write_python_log(const std::string& message, int level) {
     switch (level) {
         case 0:
             LogError(std::string(message));
             break;
         case 1:
-            LogWarning(std::string(message));
+            GSPY_LOG_WARNING(std::string(message));
             break;
         case 2:
-            LogInfo(std::string(message));
+            GSPY_LOG_INFO(std::string(message));
             break;
         case 3:
-            LogDebug(std::string(message));
+            GSPY_LOG_DEBUG(std::string(message));
             break;
         default:
-            LogInfo(std::string(message)); // Default to INFO
+            GSPY_LOG_INFO(std::string(message)); // Default to INFO
             break;
     }
+}
+
+static void report_suppressed(LogSiteWindow& window) {
+    if (window.suppressed == 0) return;
+    write_python_log("gspy.log at " + window.where + ": suppressed " + std::to_string(window.suppressed) + " similar message(s)", window.level);
+    window.suppressed = 0;
+}
+
+// "script.py:42" for the summary lines
+static std::string describe_call_site(PyObject* code, int line) {
+    std::string where = "<unknown>";
+    PyObject* filename = PyObject_GetAttrString(code, "co_filename");
+    const char* text = filename != nullptr ? PyUnicode_AsUTF8(filename) : nullptr;
+    if (text != nullptr) {
+        where = text;
+        size_t slash = where.find_last_of("/\\");
+        if (slash != std::string::npos) where = where.substr(slash + 1);
+    }
+    else {
+        PyErr_Clear();
+    }
+    Py_XDECREF(filename);
+    return where + ":" + std::to_string(line);
+}
+
+// Sampling: INFO/DEBUG messages only in calculations 1, N+1, 2N+1, ... (and outside calculations)
+static bool sampled_out(int level) {
+    return level >= LOG_INFO && log_sample_every > 1 && calculation_count > 0 && (calculation_count - 1) % log_sample_every != 0;
+}
+
+// Per-call-site rate limit: at most log_rate_limit messages in each one-second window. The
+// count suppressed in a window is reported when the site next logs, or at cleanup.
+static bool rate_limit_allows(int level) {
+    if (log_rate_limit <= 0 || level == LOG_ERROR) return true;
+    PyFrameObject* frame = PyEval_GetFrame();
+    if (frame == nullptr) return true;
+
+    LogCallSite key{ (PyObject*)PyFrame_GetCode(frame), PyFrame_GetLineNumber(frame) };
+    auto it = log_sites.find(key);
+    if (it == log_sites.end()) {
+        it = log_sites.emplace(key, LogSiteWindow()).first;   // Keeps the code reference
+        it->second.where = describe_call_site(key.code, key.line);
+    }
+    else {
+        Py_DECREF(key.code);
+    }
+
+    LogSiteWindow& window = it->second;
+    long long second = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (second != window.second) {
+        report_suppressed(window);
+        window.second = second;
+        window.count = 0;
+    }
+    window.level = level;
+    if (window.count >= log_rate_limit) {
+        ++window.suppressed;
+        return false;
+    }
+    ++window.count;
+    return true;
+}
+
+// Reports outstanding suppressed counts and drops the code references
+static void release_log_sites() {
+    for (auto& entry : log_sites) {
+        report_suppressed(entry.second);
+        Py_DECREF(entry.first.code);
+    }
+    log_sites.clear();
+}
+
+// Python-callable logging function (static - internal use only)
+static PyObject* PythonLog(PyObject* self, PyObject* args) {
+    const char* message;
+    int level = 2; // Default to INFO level
     
+    // Parse arguments: message (required), level (optional)
+    if (!PyArg_ParseTuple(args, "s|i", &message, &level)) {
+        return nullptr;
+    }
+    if (level < LOG_ERROR || level > LOG_DEBUG) level = LOG_INFO;
+    if (!ShouldLog(static_cast<LogLevel>(level))) {
+        Py_RETURN_NONE;
+    }
+
+    if (sampled_out(level) || !rate_limit_allows(level)) {
+        Py_RETURN_NONE;
+    }
+
+    write_python_log(message, level);
     Py_RETURN_NONE;
 }
 
+// =================================================================
+// gspy.LogHandler: a logging.Handler subclass implemented in C
+// =================================================================
+
+static PyObject* log_handler_type = nullptr;
+
+// Python logging levels for GSPy log levels 0..3
+static const int python_logging_levels[] = {40, 30, 20, 10};   // ERROR, WARNING, INFO, DEBUG
+
+static int gspy_level_for(long levelno) {
+    if (levelno >= 40) return LOG_ERROR;
+    if (levelno >= 30) return LOG_WARNING;
+    if (levelno >= 20) return LOG_INFO;
+    return LOG_DEBUG;
+}
+
+// Writes one LogRecord. The level check comes first, so a record the bridge drops is never
+// formatted. Plain records (no % arguments, no traceback) are logged from record.msg as-is;
+// only records with arguments pay for getMessage(), and the Formatter is used only when there
+// is exception or stack text to append. Returns 1 if written, 0 if dropped, -1 on error.
+static int emit_log_record(PyObject* handler, PyObject* record) {
+    PyObject* levelno = PyObject_GetAttrString(record, "levelno");
+    if (levelno == nullptr) return -1;
+    long python_level = PyLong_AsLong(levelno);
+    Py_DECREF(levelno);
+    if (python_level == -1 && PyErr_Occurred()) return -1;
+
+    int level = gspy_level_for(python_level);
+    if (!ShouldLog(static_cast<LogLevel>(level)) || sampled_out(level)) return 0;
+
+    PyObject* exc_info = PyObject_GetAttrString(record, "exc_info");
+    PyObject* stack_info = exc_info != nullptr ? PyObject_GetAttrString(record, "stack_info") : nullptr;
+    if (stack_info == nullptr) {
+        Py_XDECREF(exc_info);
+        return -1;
+    }
+    bool has_traceback = PyObject_IsTrue(exc_info) == 1 || PyObject_IsTrue(stack_info) == 1;
+    Py_DECREF(exc_info);
+    Py_DECREF(stack_info);
+
+    PyObject* text = nullptr;
+    if (has_traceback) {
+        text = PyObject_CallMethod(handler, "format", "O", record);
+    }
+    else {
+        PyObject* args = PyObject_GetAttrString(record, "args");
+        PyObject* msg = args != nullptr ? PyObject_GetAttrString(record, "msg") : nullptr;
+        if (msg != nullptr && PyUnicode_Check(msg) && PyObject_Not(args) == 1) {
+            text = msg;
+            msg = nullptr;
+        }
+        else if (msg != nullptr) {
+            text = PyObject_CallMethod(record, "getMessage", nullptr);
+        }
+        Py_XDECREF(args);
+        Py_XDECREF(msg);
+    }
+    if (text == nullptr) return -1;
+
+    Py_ssize_t size = 0;
+    const char* data = PyUnicode_Check(text) ? PyUnicode_AsUTF8AndSize(text, &size) : nullptr;
+    if (data == nullptr) {
+        Py_DECREF(text);
+        if (!PyErr_Occurred()) PyErr_SetString(PyExc_TypeError, "log message must be a string");
+        return -1;
+    }
+
+    // Records from named loggers keep the logger name, as logging's default format does
+    std::string message;
+    PyObject* name = PyObject_GetAttrString(record, "name");
+    const char* name_text = name != nullptr && PyUnicode_Check(name) ? PyUnicode_AsUTF8(name) : nullptr;
+    if (name_text != nullptr && strcmp(name_text, "root") != 0) {
+        message = name_text;
+        message += ": ";
+    }
+    PyErr_Clear();
+    Py_XDECREF(name);
+    message.append(data, static_cast<size_t>(size));
+    Py_DECREF(text);
+
+    write_python_log(message, level);
+    return 1;
+}
+
+// Handler.emit(record)
+static PyObject* log_handler_emit(PyObject* self, PyObject* record) {
+    if (emit_log_record(self, record) < 0) return nullptr;
+    Py_RETURN_NONE;
+}
+
+// Handler.handle(record): filters (only if any were added), then emit. No handler lock is
+// taken; the GIL is held and the bridge logger is thread-safe.
+static PyObject* log_handler_handle(PyObject* self, PyObject* record) {
+    PyObject* filters = PyObject_GetAttrString(self, "filters");
+    if (filters == nullptr) return nullptr;
+    int has_filters = PyObject_IsTrue(filters);
+    Py_DECREF(filters);
+    if (has_filters == 1) {
+        PyObject* passed = PyObject_CallMethod(self, "filter", "O", record);
+        if (passed == nullptr) return nullptr;
+        int keep = PyObject_IsTrue(passed);
+        Py_DECREF(passed);
+        if (keep != 1) Py_RETURN_FALSE;
+    }
+
+    int written = emit_log_record(self, record);
+    if (written < 0) return nullptr;
+    return PyBool_FromLong(written);
+}
+
+static PyMethodDef log_handler_methods[] = {
+    {"emit", log_handler_emit, METH_O, "Write the record to the GSPy log"},
+    {"handle", log_handler_handle, METH_O, "Check the GSPy log level, then write the record to the GSPy log"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+static PyType_Slot log_handler_slots[] = {
+    {Py_tp_doc, (void*)"logging.Handler that writes records to the GSPy log, checking the GSPy log level before formatting"},
+    {Py_tp_methods, log_handler_methods},
+    {0, nullptr}
+};
+
+static PyType_Spec log_handler_spec = {
+    "gspy.LogHandler", 0, 0, Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, log_handler_slots
+};
+
+// Adds gspy.LogHandler, derived from logging.Handler
+static bool add_log_handler_type(PyObject* module) {
+    if (log_handler_type == nullptr) {
+        PyObject* logging = PyImport_ImportModule("logging");
+        PyObject* base = logging != nullptr ? PyObject_GetAttrString(logging, "Handler") : nullptr;
+        Py_XDECREF(logging);
+        if (base == nullptr) return false;
+        log_handler_type = PyType_FromSpecWithBases(&log_handler_spec, base);
+        Py_DECREF(base);
+        if (log_handler_type == nullptr) return false;
+    }
+    Py_INCREF(log_handler_type);
+    return PyModule_AddObject(module, "LogHandler", log_handler_type) == 0;
+}
+
 // Python-callable error function that signals a fatal error to GoldSim
 // NOTE: For 64-bit DLLs running in separate process space, we cannot pass
 // pointers to GoldSim. Instead, we raise a Python exception that C++ will catch.
@@ -90,7 +388,7 @@ static PyObject* PythonError(PyObject* self, PyObject* args) {
         *g_python_error_message = message;
     }
     
-    LogDebug("gspy.error() called, message stored: " + std::string(message));
+    GSPY_LOG_DEBUG("gspy.error() called, message stored: " + std::string(message));
     
     // Raise a Python RuntimeError with the message
     // This will cause PyObject_CallObject to return NULL, triggering our error handling
@@ -103,6 +401,9 @@ static PyObject* PythonError(PyObject* self, PyObject* args) {
 static PyMethodDef GSPyMethods[] = {
     {"log", PythonLog, METH_VARARGS, "Write a message to the GSPy log file"},
     {"error", PythonError, METH_VARARGS, "Signal a fatal error to GoldSim and terminate the simulation"},
+    {"changed", PythonChanged, METH_VARARGS, "Report whether an input (or, as a bitmask, which inputs) changed since the previous call"},
+    {"shared_array", PythonSharedArray, METH_VARARGS, "Return a read-only, memory-mapped view of a .npy dataset shared across realizations"},
+    {"resample", (PyCFunction)(void(*)(void))PythonResample, METH_VARARGS | METH_KEYWORDS, "Interpolate a time series onto new timestamps (linear, previous or next)"},
     {nullptr, nullptr, 0, nullptr} // Sentinel
 };
 
@@ -117,7 +418,25 @@ static struct PyModuleDef gspymodule = {
 
 // Module initialization function
 PyObject* PyInit_gspy(void) {
-    return PyModule_Create(&gspymodule);
+    PyObject* module = PyModule_Create(&gspymodule);
+    if (module == nullptr) return nullptr;
+
+    // gspy.scalar_index maps each scalar input name to its position in the packed array
+    if (input_mode == InputMode::PackedScalars) {
+        PyObject* index = PyDict_New();
+        for (size_t i = 0; i < packed_scalar_names.size(); ++i) {
+            PyObject* position = PyLong_FromSize_t(i);
+            PyDict_SetItemString(index, packed_scalar_names[i].c_str(), position);
+            Py_DECREF(position);
+        }
+        PyModule_AddObject(module, "scalar_index", index); // Steals reference to index
+    }
+
+    if (!AddTimeSeriesTypes(module) || !AddTableTypes(module) || !AddUnchangedSentinel(module) || !add_log_handler_type(module)) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
 }
 
 // =================================================================
@@ -125,16 +444,16 @@ PyObject* PyInit_gspy(void) {
 // =================================================================
 static std::string read_config() {
     std::string config_path = GetConfigFilename();
-    LogDebug("Reading config file: " + config_path);
+    GSPY_LOG_DEBUG("Reading config file: " + config_path);
     std::ifstream f(config_path);
     if (f.is_open()) {
-        LogDebug("Config file opened successfully.");
+        GSPY_LOG_DEBUG("Config file opened successfully.");
         std::string file_contents((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
         f.clear();
         f.seekg(0, std::ios::beg); // Reset file pointer for parsing
         try {
             config = json::parse(file_contents);
-            LogDebug("Config file parsed successfully.");
+            GSPY_LOG_DEBUG("Config file parsed successfully.");
             return ""; // Success
         }
         catch (json::parse_error& e) {
@@ -158,9 +477,138 @@ static int calculate_total_elements(const json& dimensions) {
     return total;
 }
 
+// Time series and tables carry their own sizes, so their length in inargs is only known per call
+static bool is_variable_length(const json& input) {
+    return input["type"] == "timeseries" || input["type"] == "table";
+}
+
+// Outputs with a "source" file are written by the bridge; the script never returns them
+static bool is_file_output(const json& output) {
+    return output.contains("source");
+}
+
+// Returns true if every output comes from a file, so no Python function is needed
+static bool all_outputs_from_files() {
+    for (const auto& output : config["outputs"]) {
+        if (!is_file_output(output)) return false;
+    }
+    return !config["outputs"].empty();
+}
+
+// Number of doubles GoldSim reserves in outargs for one output.
+static int output_length(const json& output) {
+    std::string type = output["type"];
+
+    if (type == "timeseries") {
+        // Your correct, detailed calculation for Time Series
+        int max_points = output.value("max_points", 1);
+        const auto& dims = output["dimensions"];
+        int data_multiplier = 1;
+        // Note: A scalar TS has 0 dims, a vector has 1, a matrix has 2.
+        // The data array shape is (rows, cols, time_points).
+        // data_multiplier here will be rows * cols.
+        if (!dims.empty()) data_multiplier *= dims[0].get<int>(); // rows
+        if (dims.size() > 1) data_multiplier *= dims[1].get<int>(); // cols
+
+        // Total size = 7 header doubles + per series (point count + N timestamps + N * rows * cols data values)
+        int num_series = output.value("num_series", 1);
+        return 7 + num_series * (1 + max_points + (max_points * data_multiplier));
+    }
+    else if (type == "table") {
+        // For tables, the structure is more complex, so we rely on the user's max_elements estimate.
+        return output.value("max_elements", 1);
+    }
+    // Standard calculation for fixed-size arrays (scalar, vector, matrix)
+    return calculate_total_elements(output["dimensions"]);
+}
+
+// --- Reads the gspy.log throttling settings ---
+static bool configure_python_logging(std::string& errorMessage) {
+    log_rate_limit = config.value("log_rate_limit", 0);
+    long long sample_every = config.value("log_sample_every", 1LL);
+    if (log_rate_limit < 0 || sample_every < 1) {
+        errorMessage = "Error: 'log_rate_limit' must be 0 or more and 'log_sample_every' 1 or more.";
+        LogError(errorMessage);
+        return false;
+    }
+    log_sample_every = static_cast<unsigned long long>(sample_every);
+    if (log_rate_limit > 0 || log_sample_every > 1) {
+        GSPY_LOG_DEBUG("gspy.log throttling: " + std::to_string(log_rate_limit) + " message(s) per call site per second (0 = unlimited), INFO/DEBUG every " +
+                       std::to_string(log_sample_every) + " calculation(s).");
+    }
+    return true;
+}
+
+// --- Reads "input_mode" and precomputes any layout the chosen mode needs ---
+static bool configure_input_mode(std::string& errorMessage) {
+    std::string mode = config.value("input_mode", "tuple");
+    packed_scalar_names.clear();
+    packed_scalar_offset = -1;
+
+    if (mode == "tuple") {
+        input_mode = InputMode::Tuple;
+    }
+    else if (mode == "packed_scalars") {
+        input_mode = InputMode::PackedScalars;
+
+        // Offsets are static only up to the first (variable-length) time series
+        long offset = 0;
+        bool contiguous = true;
+        for (const auto& input : config["inputs"]) {
+            std::string type = input["type"];
+            if (type == "scalar") {
+                if (packed_scalar_names.empty()) {
+                    packed_scalar_offset = offset;
+                }
+                else if (offset != packed_scalar_offset + static_cast<long>(packed_scalar_names.size())) {
+                    contiguous = false;
+                }
+                packed_scalar_names.push_back(input.value("name", ""));
+            }
+            if (is_variable_length(input)) {
+                offset = -1;
+            }
+            else if (offset >= 0) {
+                offset += calculate_total_elements(input["dimensions"]);
+            }
+        }
+        if (!contiguous || packed_scalar_offset < 0) {
+            packed_scalar_offset = -1;
+            packed_scalar_buffer.resize(packed_scalar_names.size());
+        }
+        GSPY_LOG_DEBUG("Packed scalar mode: " + std::to_string(packed_scalar_names.size()) + " scalar(s), " +
+                       (packed_scalar_offset >= 0 ? "zero-copy view at offset " + std::to_string(packed_scalar_offset) : std::string("gathered")) + ".");
+    }
+    else if (mode == "keywords") {
+        input_mode = InputMode::Keywords;
+    }
+    else if (mode == "lazy") {
+        input_mode = InputMode::Lazy;
+    }
+    else if (mode == "record") {
+        input_mode = InputMode::Record;
+        record_field_count = 0;
+        for (const auto& input : config["inputs"]) {
+            if (is_variable_length(input)) break;
+            ++record_field_count;
+        }
+        if (record_field_count == 0) {
+            errorMessage = "Error: input_mode 'record' needs at least one scalar, vector or matrix input before the first time series or table.";
+            LogError(errorMessage);
+            return false;
+        }
+    }
+    else {
+        errorMessage = "Error: Unknown input_mode '" + mode + "'.";
+        LogError(errorMessage);
+        return false;
+    }
+    return true;
+}
+
 // --- Initializes the NumPy C-API ---
 static bool initialize_numpy(std::string& errorMessage) {
-    LogDebug("Initializing NumPy C-API...");
+    GSPY_LOG_DEBUG("Initializing NumPy C-API...");
     
     // Step 1: Explicitly import numpy module (required for Python 3.12+)
     PyObject* pNumpy = PyImport_ImportModule("numpy");
@@ -182,29 +630,215 @@ static bool initialize_numpy(std::string& errorMessage) {
         return false;
     }
     
-    LogDebug("NumPy C-API initialized successfully.");
+    GSPY_LOG_DEBUG("NumPy C-API initialized successfully.");
+    return true;
+}
+
+// --- Builds the structured dtype used by the "record" input mode ---
+static bool build_record_dtype(std::string& errorMessage) {
+    if (input_mode != InputMode::Record) return true;
+
+    // Equivalent to numpy.dtype((numpy.record, {'names': ..., 'formats': ..., 'offsets': ..., 'itemsize': ...}))
+    PyObject* names = PyList_New(0);
+    PyObject* formats = PyList_New(0);
+    PyObject* offsets = PyList_New(0);
+    long offset = 0;
+    const auto& inputs = config["inputs"];
+    for (size_t i = 0; i < record_field_count; ++i) {
+        const auto& input = inputs[i];
+        PyObject* name = PyUnicode_FromString(input.value("name", "").c_str());
+        PyObject* format = nullptr;
+        if (input["type"] == "scalar") {
+            format = PyUnicode_FromString("f8");
+        }
+        else {
+            PyObject* shape = PyTuple_New(input["dimensions"].size());
+            for (size_t d = 0; d < input["dimensions"].size(); ++d) {
+                PyTuple_SetItem(shape, d, PyLong_FromLong(input["dimensions"][d].get<long>()));
+            }
+            format = Py_BuildValue("(sN)", "f8", shape);
+        }
+        PyObject* field_offset = PyLong_FromLong(offset * static_cast<long>(sizeof(double)));
+        PyList_Append(names, name);
+        PyList_Append(formats, format);
+        PyList_Append(offsets, field_offset);
+        Py_DECREF(name);
+        Py_DECREF(format);
+        Py_DECREF(field_offset);
+        offset += calculate_total_elements(input["dimensions"]);
+    }
+    PyObject* spec = Py_BuildValue("{sNsNsNsl}", "names", names, "formats", formats, "offsets", offsets,
+                                   "itemsize", offset * static_cast<long>(sizeof(double)));
+
+    PyObject* pNumpy = PyImport_ImportModule("numpy");
+    PyObject* pRecordType = pNumpy ? PyObject_GetAttrString(pNumpy, "record") : nullptr;
+    PyObject* pDtypeSpec = pRecordType ? Py_BuildValue("(OO)", pRecordType, spec) : nullptr;
+    Py_XDECREF(pRecordType);
+    Py_XDECREF(pNumpy);
+    Py_DECREF(spec);
+
+    if (!pDtypeSpec || !PyArray_DescrConverter(pDtypeSpec, &record_descr)) {
+        Py_XDECREF(pDtypeSpec);
+        PyErr_Print();
+        errorMessage = "Error: Could not build the record dtype from the input configuration. Check for duplicate or empty input names.";
+        LogError(errorMessage);
+        return false;
+    }
+    Py_DECREF(pDtypeSpec);
+    GSPY_LOG_DEBUG("Record input mode: " + std::to_string(record_field_count) + " field(s), " + std::to_string(offset) + " double(s).");
     return true;
 }
 
+// --- Interns input and output names for keyword calls and dict results ---
+static void intern_io_names() {
+    for (const auto& input : config["inputs"]) {
+        input_name_keys.push_back(PyUnicode_InternFromString(input.value("name", "").c_str()));
+    }
+    for (const auto& output : config["outputs"]) {
+        output_name_keys.push_back(PyUnicode_InternFromString(output.value("name", "").c_str()));
+    }
+    empty_args = PyTuple_New(0);
+}
+
+// --- With "python_logging", attaches gspy.LogHandler and sets the root logger's level from log_level ---
+static bool configure_logging_bridge(std::string& errorMessage) {
+    // Without the bridge the script's own logging setup is left alone
+    if (!config.value("python_logging", false)) return true;
+
+    PyObject* logging = PyImport_ImportModule("logging");
+    PyObject* root = logging != nullptr ? PyObject_CallMethod(logging, "getLogger", nullptr) : nullptr;
+    Py_XDECREF(logging);
+    if (root == nullptr) {
+        PyErr_Print();
+        errorMessage = "Error: Failed to get the Python root logger.";
+        LogError(errorMessage);
+        return false;
+    }
+
+    // Records below the GSPy log level are then discarded by the logger before a LogRecord exists
+    int level = current_log_level_atomic.load(std::memory_order_relaxed);
+    if (level < LOG_ERROR) level = LOG_ERROR;
+    if (level > LOG_DEBUG) level = LOG_DEBUG;
+    PyObject* result = PyObject_CallMethod(root, "setLevel", "i", python_logging_levels[level]);
+    bool ok = result != nullptr;
+    Py_XDECREF(result);
+
+    if (ok) {
+        PyObject* gspy = PyImport_ImportModule("gspy");
+        PyObject* handler = gspy != nullptr && log_handler_type != nullptr ? PyObject_CallObject(log_handler_type, nullptr) : nullptr;
+        Py_XDECREF(gspy);
+        result = handler != nullptr ? PyObject_CallMethod(root, "addHandler", "O", handler) : nullptr;
+        ok = result != nullptr;
+        Py_XDECREF(result);
+        Py_XDECREF(handler);
+        if (ok) GSPY_LOG_DEBUG("Python logging records are forwarded to the GSPy log by gspy.LogHandler.");
+    }
+    Py_DECREF(root);
+
+    if (!ok) {
+        PyErr_Print();
+        errorMessage = "Error: Failed to configure Python logging for GSPy.";
+        LogError(errorMessage);
+    }
+    return ok;
+}
+
 // --- Adds the current directory to Python's search path ---
 static bool add_script_path_to_sys() {
-    LogDebug("Adding current directory to Python sys.path...");
+    GSPY_LOG_DEBUG("Adding current directory to Python sys.path...");
     PyObject* sys = PyImport_ImportModule("sys");
     PyObject* path = PyObject_GetAttrString(sys, "path");
     PyList_Append(path, PyUnicode_FromString("."));
     Py_DECREF(path);
     Py_DECREF(sys);
-    LogDebug("Current directory added to path.");
+    GSPY_LOG_DEBUG("Current directory added to path.");
+    return true;
+}
+
+// --- Loads every output that names a "source" file ---
+static bool load_output_sources(std::string& errorMessage) {
+    for (const auto& output : config["outputs"]) {
+        if (is_file_output(output) && !LoadOutputSource(output, output_length(output), errorMessage)) return false;
+    }
+    return true;
+}
+
+// Returns true if any output names its own producing function (dependency-graph mode)
+static bool uses_output_graph() {
+    for (const auto& output : config["outputs"]) {
+        if (output.contains("function") && !is_file_output(output)) return true;
+    }
+    return false;
+}
+
+// --- Resolves per-output functions and their input dependencies ---
+static bool build_output_graph(const std::string& script_path_full, std::string& errorMessage) {
+    std::map<std::string, size_t> input_indices;
+    const auto& inputs = config["inputs"];
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        input_indices[inputs[i].value("name", "")] = i;
+    }
+
+    output_nodes.clear();
+    for (const auto& output : config["outputs"]) {
+        std::string output_name = output.value("name", "");
+        if (is_file_output(output)) {
+            output_nodes.push_back(OutputNode());
+            continue;
+        }
+        if (!output.contains("function")) {
+            errorMessage = "Error: Output '" + output_name + "' has no 'function'. When any output declares a function, all outputs must.";
+            LogError(errorMessage);
+            return false;
+        }
+
+        OutputNode node;
+        std::string function_name = output["function"];
+        node.func = PyObject_GetAttrString(pModule, function_name.c_str());
+        if (!node.func || !PyCallable_Check(node.func)) {
+            PyErr_Clear();
+            Py_XDECREF(node.func);
+            errorMessage = "Error: Cannot find function '" + function_name + "' for output '" + output_name + "' in script '" + script_path_full + "'.";
+            LogError(errorMessage);
+            return false;
+        }
+
+        if (output.contains("depends_on")) {
+            node.depends_on_all = false;
+            for (const auto& dependency : output["depends_on"]) {
+                std::string input_name = dependency;
+                auto it = input_indices.find(input_name);
+                if (it == input_indices.end()) {
+                    Py_DECREF(node.func);
+                    errorMessage = "Error: Output '" + output_name + "' depends on unknown input '" + input_name + "'.";
+                    LogError(errorMessage);
+                    return false;
+                }
+                node.dependencies.push_back(it->second);
+            }
+        }
+
+        GSPY_LOG_DEBUG("Output '" + output_name + "' is produced by '" + function_name + "' (" +
+                       (node.depends_on_all ? std::string("all inputs") : std::to_string(node.dependencies.size()) + " dependencies") + ").");
+        output_nodes.push_back(std::move(node));
+    }
     return true;
 }
 
 // --- Loads the user's script and gets the target function ---
 static bool load_script_and_function(std::string& errorMessage) {
+    if (all_outputs_from_files() && !config.contains("function_name")) {
+        GSPY_LOG_INFO("Every output is read from a file; no Python script is loaded.");
+        return true;
+    }
+
     std::string script_path_full = config["script_path"];
-    std::string function_name = config["function_name"];
+    bool output_graph = uses_output_graph();
+    // In dependency-graph mode each output names its own function instead
+    std::string function_name = output_graph ? config.value("function_name", "") : config["function_name"].get<std::string>();
     
-    LogDebug("Script path from config: " + script_path_full);
-    LogDebug("Function name from config: " + function_name);
+    GSPY_LOG_DEBUG("Script path from config: " + script_path_full);
+    GSPY_LOG_DEBUG("Function name from config: " + function_name);
 
     std::string script_path_module = script_path_full;
     size_t dot_pos = script_path_module.find(".py");
@@ -212,16 +846,20 @@ static bool load_script_and_function(std::string& errorMessage) {
         script_path_module = script_path_module.substr(0, dot_pos);
     }
 
-    LogDebug("Attempting to import Python module: " + script_path_module);
+    GSPY_LOG_DEBUG("Attempting to import Python module: " + script_path_module);
     pModule = PyImport_ImportModule(script_path_module.c_str());
 
     if (pModule != nullptr) {
-        LogDebug("Module imported successfully.");
-        LogDebug("Attempting to get function '" + function_name + "' from module...");
+        GSPY_LOG_DEBUG("Module imported successfully.");
+        if (output_graph) {
+            return build_output_graph(script_path_full, errorMessage);
+        }
+
+        GSPY_LOG_DEBUG("Attempting to get function '" + function_name + "' from module...");
         pFunc = PyObject_GetAttrString(pModule, function_name.c_str());
 
         if (pFunc && PyCallable_Check(pFunc)) {
-            LogDebug("Function found successfully.");
+            GSPY_LOG_DEBUG("Function found successfully.");
             return true;
         }
         else {
@@ -238,93 +876,294 @@ static bool load_script_and_function(std::string& errorMessage) {
     }
 }
 
+// Wraps the packed scalars in a read-only 1-D float64 array (zero-copy when the layout allows it).
+static PyObject* MakePackedScalarArray(double* inargs) {
+    npy_intp dims[] = { static_cast<npy_intp>(packed_scalar_names.size()) };
+    double* data = packed_scalar_offset >= 0 ? inargs + packed_scalar_offset : packed_scalar_buffer.data();
+    PyObject* pArray = PyArray_SimpleNewFromData(1, dims, NPY_FLOAT64, data);
+    PyArray_CLEARFLAGS((PyArrayObject*)pArray, NPY_ARRAY_WRITEABLE);
+    return pArray;
+}
+
+// Returns the structured record over the leading fixed-size inputs (new reference).
+// The view is cached and only rebuilt when GoldSim hands us a different inargs buffer.
+static PyObject* GetRecordView(double* inargs) {
+    if (record_view == nullptr || record_view_data != inargs) {
+        Py_XDECREF(record_view);
+        Py_INCREF(record_descr); // PyArray_NewFromDescr steals a reference
+        PyObject* pArray = PyArray_NewFromDescr(&PyArray_Type, record_descr, 0, nullptr, nullptr,
+                                                inargs, NPY_ARRAY_CARRAY_RO, nullptr);
+        // Indexing a 0-d structured array with () yields a numpy.record that still points into inargs
+        PyObject* pEmpty = PyTuple_New(0);
+        record_view = pArray ? PyObject_GetItem(pArray, pEmpty) : nullptr;
+        Py_DECREF(pEmpty);
+        Py_XDECREF(pArray);
+        record_view_data = record_view ? inargs : nullptr;
+    }
+    Py_XINCREF(record_view);
+    return record_view;
+}
+
+// Builds the Python object for input #index: a float, a NumPy view, a time series or a table dictionary.
+static PyObject* MarshalInputItem(const json& input, size_t index, double* input_start) {
+    std::string type = input["type"];
+
+    if (type == "timeseries") {
+        // Delegate to our specialist. Unchanged definitions reuse the previous object unless "cache" is off.
+        if (input.value("cache", true)) {
+            return MarshalCachedGoldSimTimeSeriesToPython(input_start, index, input);
+        }
+        double* ts_pointer = input_start;
+        return MarshalGoldSimTimeSeriesToPython(ts_pointer, input);
+    }
+    else if (type == "table") {
+        return MarshalGoldSimLookupTableToPython(input_start, input);
+    }
+    else if (type == "scalar") {
+        return PyFloat_FromDouble(*input_start);
+    }
+    else { // Vector or Matrix
+        const auto& dims_json = input["dimensions"];
+        std::vector<npy_intp> dims_vec;
+        for (const auto& dim : dims_json) {
+            dims_vec.push_back(dim.get<npy_intp>());
+        }
+        return PyArray_SimpleNewFromData(static_cast<int>(dims_vec.size()), dims_vec.data(), NPY_FLOAT64, input_start);
+    }
+}
+
+// Number of doubles one input occupies in inargs.
+static long input_length(const json& input, const double* input_start) {
+    if (input["type"] == "timeseries") {
+        return GetGoldSimTimeSeriesLength(input_start);
+    }
+    if (input["type"] == "table") {
+        return GetGoldSimLookupTableLength(input_start);
+    }
+    return calculate_total_elements(input["dimensions"]);
+}
+
 // This function prepares the tuple of arguments to be sent to Python.
 static PyObject* MarshalInputsToPython(const json& inputs_config, double* inargs) {
-    LogDebug("Preparing " + std::to_string(inputs_config.size()) + " input argument(s) for Python.");
-    PyObject* pArgs = PyTuple_New(inputs_config.size());
+    GSPY_LOG_EVENT(PreparingInputs, inputs_config.size());
+    bool pack_scalars = input_mode == InputMode::PackedScalars;
+    bool use_record = input_mode == InputMode::Record;
+    bool lazy = input_mode == InputMode::Lazy;
+    bool keywords = input_mode == InputMode::Keywords;
+    size_t num_args = inputs_config.size();
+    if (pack_scalars) num_args = inputs_config.size() - packed_scalar_names.size() + 1;
+    if (use_record) num_args = inputs_config.size() - record_field_count + 1;
+    if (lazy) num_args = 1;
+    // In keyword mode pArgs is the kwargs dictionary rather than a tuple
+    PyObject* pArgs = keywords ? PyDict_New() : PyTuple_New(num_args);
     double* current_inarg_pointer = inargs; // Use a pointer we can advance
+    input_slices.resize(inputs_config.size());
+    size_t arg_index = (pack_scalars || use_record) ? 1 : 0; // Packed scalars or the record occupy argument 0
+    size_t scalar_index = 0;
 
     for (int i = 0; i < inputs_config.size(); ++i) {
         const auto& input = inputs_config[i];
         std::string type = input["type"];
         PyObject* pValue = nullptr;
+        long length = input_length(input, current_inarg_pointer);
 
-        LogDebug("  Input #" + std::to_string(i) + ": Type='" + type + "'");
+        GSPY_LOG_EVENT(InputType, i, type);
+        GSPY_RECORD_EVENT(InputSize, i, PyUnicode_AsUTF8(input_name_keys[i]), length);
 
-        if (type == "timeseries") {
-            // Delegate to our specialist
-            pValue = MarshalGoldSimTimeSeriesToPython(current_inarg_pointer, input);
+        if (lazy) {
+            // Built on first access by the LazyInputs object
         }
-        else if (type == "scalar") {
-            pValue = PyFloat_FromDouble(*current_inarg_pointer);
-            current_inarg_pointer += 1; // Advance pointer by 1
+        else if (use_record && static_cast<size_t>(i) < record_field_count) {
+            // Already a field of the record view
         }
-        else { // Vector or Matrix
-            int num_elements = calculate_total_elements(input["dimensions"]);
-            const auto& dims_json = input["dimensions"];
-            std::vector<npy_intp> dims_vec;
-            for (const auto& dim : dims_json) {
-                dims_vec.push_back(dim.get<npy_intp>());
-            }
-            pValue = PyArray_SimpleNewFromData(static_cast<int>(dims_vec.size()), dims_vec.data(), NPY_FLOAT64, current_inarg_pointer);
-            current_inarg_pointer += num_elements; // Advance pointer by the size of the array
+        else if (pack_scalars && type == "scalar") {
+            if (packed_scalar_offset < 0) packed_scalar_buffer[scalar_index] = *current_inarg_pointer;
+            ++scalar_index;
+        }
+        else {
+            pValue = MarshalInputItem(input, i, current_inarg_pointer);
+        }
+        input_slices[i] = { static_cast<size_t>(current_inarg_pointer - inargs), static_cast<size_t>(length) };
+        current_inarg_pointer += length; // Advance pointer past this input
+        if (pValue != nullptr && keywords) {
+            PyDict_SetItem(pArgs, input_name_keys[i], pValue);
+            Py_DECREF(pValue);
+        }
+        else if (pValue != nullptr) {
+            PyTuple_SetItem(pArgs, arg_index++, pValue); // Steals reference to pValue
+        }
+    }
+
+    if (pack_scalars) {
+        PyTuple_SetItem(pArgs, 0, MakePackedScalarArray(inargs));
+    }
+    if (use_record || lazy) {
+        PyObject* pFirst = use_record ? GetRecordView(inargs) : CreateLazyInputs(inargs, input_slices);
+        if (pFirst == nullptr) {
+            PyErr_Print();
+            Py_DECREF(pArgs);
+            return nullptr;
         }
-        PyTuple_SetItem(pArgs, i, pValue); // Steals reference to pValue
+        PyTuple_SetItem(pArgs, 0, pFirst);
     }
     return pArgs;
 }
 
-// This function unpacks the tuple of results from Python and copies the data back.
+// Calls func with the marshalled inputs, as keyword arguments in keyword mode.
+static PyObject* CallWithInputs(PyObject* func, PyObject* pArgs) {
+    if (input_mode == InputMode::Keywords) {
+        return PyObject_Call(func, empty_args, pArgs);
+    }
+    return PyObject_CallObject(func, pArgs);
+}
+
+// Copies a single Python result into outargs according to its output config.
+static bool MarshalOutputItem(PyObject* pItem, const json& output_config, double*& current_outarg_pointer, std::string& errorMessage) {
+    std::string type = output_config["type"];
+
+    if (type == "timeseries") {
+        return MarshalPythonTimeSeriesToGoldSim(pItem, output_config, current_outarg_pointer, errorMessage);
+    }
+    else if (type == "table") {
+        return MarshalPythonLookupTableToGoldSim(pItem, output_config, current_outarg_pointer, errorMessage);
+    }
+    else if (PyArray_Check(pItem)) { // Handle Vector or Matrix
+        int expected_size = calculate_total_elements(output_config["dimensions"]);
+        memcpy(current_outarg_pointer, PyArray_DATA((PyArrayObject*)pItem), expected_size * sizeof(double));
+        current_outarg_pointer += expected_size;
+    }
+    else { // Handle Scalar
+        *current_outarg_pointer = PyFloat_AsDouble(pItem);
+        current_outarg_pointer += 1;
+    }
+    return true;
+}
+
+// This function unpacks the tuple (or dict keyed by output name) of results from Python and copies the data back.
 static bool MarshalOutputsToCpp(PyObject* pResultTuple, const json& outputs_config, double* outargs, std::string& errorMessage) {
-    if (!pResultTuple || !PyTuple_Check(pResultTuple)) {
+    bool is_dict = pResultTuple && PyDict_Check(pResultTuple);
+    if (!pResultTuple || (!is_dict && !PyTuple_Check(pResultTuple))) {
         PyErr_Print();
-        errorMessage = "Error: Python call failed or did not return a tuple.";
+        errorMessage = "Error: Python call failed or did not return a tuple or dict.";
         LogError(errorMessage);
+        Py_XDECREF(pResultTuple);
         return false;
     }
 
-    LogDebug("Python call successful. Processing " + std::to_string(PyTuple_Size(pResultTuple)) + " result(s).");
+    Py_ssize_t num_results = is_dict ? static_cast<Py_ssize_t>(outputs_config.size()) : PyTuple_Size(pResultTuple);
+    GSPY_LOG_EVENT(PythonCallDone, num_results);
     double* current_outarg_pointer = outargs;
 
-    for (Py_ssize_t i = 0; i < PyTuple_Size(pResultTuple); ++i) {
-        PyObject* pItem = PyTuple_GetItem(pResultTuple, i);
+    // File outputs take no slot in the result tuple, so results are counted separately
+    Py_ssize_t result_index = 0;
+    for (Py_ssize_t i = 0; i < static_cast<Py_ssize_t>(outputs_config.size()); ++i) {
         const auto& output_config = outputs_config[i];
-        std::string type = output_config["type"];
-        LogDebug("  Output #" + std::to_string(i) + ": Type='" + type + "'");
-
-        if (type == "timeseries") {
-            if (!MarshalPythonTimeSeriesToGoldSim(pItem, output_config, current_outarg_pointer, errorMessage)) {
-                Py_DECREF(pResultTuple);
-                return false;
-            }
+        double* output_start = current_outarg_pointer;
+        if (is_file_output(output_config)) {
+            WriteOutputSource(output_config, current_outarg_pointer);
+            GSPY_RECORD_EVENT(OutputSize, i, PyUnicode_AsUTF8(output_name_keys[i]), current_outarg_pointer - output_start);
+            continue;
         }
-        else if (type == "table") {
-            if (!MarshalPythonLookupTableToGoldSim(pItem, output_config, current_outarg_pointer, errorMessage)) {
+        if (!is_dict && result_index >= num_results) break;
+
+        PyObject* pItem = nullptr;
+        if (is_dict) {
+            // Interned keys: the dict lookup short-circuits on pointer identity
+            pItem = PyDict_GetItemWithError(pResultTuple, output_name_keys[i]);
+            if (pItem == nullptr) {
+                PyErr_Clear();
+                errorMessage = "Error: Python result dict is missing output '" + output_config.value("name", "") + "'.";
+                LogError(errorMessage);
                 Py_DECREF(pResultTuple);
                 return false;
             }
         }
-        else if (PyArray_Check(pItem)) { // Handle Vector or Matrix
-            int expected_size = calculate_total_elements(output_config["dimensions"]);
-            memcpy(current_outarg_pointer, PyArray_DATA((PyArrayObject*)pItem), expected_size * sizeof(double));
-            current_outarg_pointer += expected_size;
+        else {
+            pItem = PyTuple_GetItem(pResultTuple, result_index);
         }
-        else { // Handle Scalar
-            *current_outarg_pointer = PyFloat_AsDouble(pItem);
-            current_outarg_pointer += 1;
+        ++result_index;
+        GSPY_LOG_EVENT(OutputType, i, output_config["type"].get_ref<const std::string&>());
+
+        if (!MarshalOutputItem(pItem, output_config, current_outarg_pointer, errorMessage)) {
+            Py_DECREF(pResultTuple);
+            return false;
         }
+        GSPY_RECORD_EVENT(OutputSize, i, PyUnicode_AsUTF8(output_name_keys[i]), current_outarg_pointer - output_start);
     }
     Py_DECREF(pResultTuple);
     return true;
 }
 
+// Converts a failed Python call (NULL result) into an error message for GoldSim.
+static void HandlePythonCallFailure(std::string& errorMessage) {
+    if (g_python_error_message != nullptr && !g_python_error_message->empty()) {
+        // gspy.error() was called - use the stored message
+        errorMessage = "GSPy Error: " + *g_python_error_message;
+        GSPY_LOG_DEBUG("Python signaled fatal error via gspy.error(): " + *g_python_error_message);
+        g_python_error_message->clear();
+    } else {
+        // Some other Python exception - get the error details
+        PyErr_Print();
+        errorMessage = "Python exception occurred (see log for details)";
+        LogError(errorMessage);
+    }
+}
+
+// Dependency-graph evaluation: calls only the output functions whose inputs changed
+// and replays the cached block of every other output into outargs.
+static bool EvaluateOutputGraph(PyObject* pArgs, const json& outputs_config, double* outargs, std::string& errorMessage) {
+    double* current_outarg_pointer = outargs;
+
+    for (size_t i = 0; i < output_nodes.size(); ++i) {
+        OutputNode& node = output_nodes[i];
+        if (node.func == nullptr) {
+            WriteOutputSource(outputs_config[i], current_outarg_pointer);
+            continue;
+        }
+
+        bool stale = node.last_value.empty();
+        if (!stale && node.depends_on_all) {
+            for (size_t j = 0; j < input_slices.size() && !stale; ++j) stale = InputChanged(j);
+        }
+        for (size_t j = 0; j < node.dependencies.size() && !stale; ++j) {
+            stale = InputChanged(node.dependencies[j]);
+        }
+
+        if (!stale) {
+            GSPY_LOG_EVENT(OutputReused, i);
+            memcpy(current_outarg_pointer, node.last_value.data(), node.last_value.size() * sizeof(double));
+            current_outarg_pointer += node.last_value.size();
+            continue;
+        }
+
+        GSPY_LOG_EVENT(OutputRecomputed, i);
+        PyObject* pItem = CallWithInputs(node.func, pArgs);
+        if (pItem == nullptr) {
+            HandlePythonCallFailure(errorMessage);
+            return false;
+        }
+
+        double* output_start = current_outarg_pointer;
+        bool ok = MarshalOutputItem(pItem, outputs_config[i], current_outarg_pointer, errorMessage);
+        Py_DECREF(pItem);
+        if (!ok) {
+            LogError(errorMessage);
+            node.last_value.clear();
+            return false;
+        }
+        node.last_value.assign(output_start, current_outarg_pointer);
+        GSPY_RECORD_EVENT(OutputSize, i, PyUnicode_AsUTF8(output_name_keys[i]), current_outarg_pointer - output_start);
+    }
+    return true;
+}
+
 // =================================================================
 // ## The Commander (Public Functions) ##
 // =================================================================
 
 // --- The main InitializePython function ---
 bool InitializePython(std::string& errorMessage) {
-    Log("--- Initializing Python Manager ---");
+    GSPY_LOG(LOG_INFO, "--- Initializing Python Manager ---");
 
     if (config.empty()) {
         errorMessage = read_config();
@@ -332,11 +1171,11 @@ bool InitializePython(std::string& errorMessage) {
             LogError("Error reading config: " + errorMessage);
             return false;
         }
-        LogInfo("Config read successfully.");
+        GSPY_LOG_INFO("Config read successfully.");
     }
 
     if (!Py_IsInitialized()) {
-        LogInfo("Python interpreter is not initialized. Initializing now...");
+        GSPY_LOG_INFO("Python interpreter is not initialized. Initializing now...");
 
         PyConfig py_config;
         PyConfig_InitPythonConfig(&py_config);
@@ -344,7 +1183,7 @@ bool InitializePython(std::string& errorMessage) {
         // --- REVERTED LOGIC: Get Python Home from the config file ---
         if (config.contains("python_path")) {
             std::string python_home = config["python_path"];
-            LogDebug("Using python_path from config: " + python_home);
+            GSPY_LOG_DEBUG("Using python_path from config: " + python_home);
             PyStatus status = PyConfig_SetBytesString(&py_config, &py_config.home, python_home.c_str());
             if (PyStatus_Exception(status)) {
                 errorMessage = "Error: Failed to set Python Home from config path.";
@@ -375,24 +1214,61 @@ bool InitializePython(std::string& errorMessage) {
             return false;
         }
 
+        if (!configure_input_mode(errorMessage)) return false;
+        if (!configure_python_logging(errorMessage)) return false;
         if (!initialize_numpy(errorMessage)) return false;
+        if (!build_record_dtype(errorMessage)) return false;
+        intern_io_names();
+        if (input_mode == InputMode::Lazy && !InitLazyInputs(config["inputs"], MarshalInputItem, errorMessage)) return false;
         if (!add_script_path_to_sys()) return false;
+        if (!configure_logging_bridge(errorMessage)) return false;
+        if (!PreloadSharedArrays(config, errorMessage)) return false;
+        if (!load_output_sources(errorMessage)) return false;
         if (!load_script_and_function(errorMessage)) return false;
     }
     else {
-        LogInfo("Python interpreter is already initialized.");
+        GSPY_LOG_INFO("Python interpreter is already initialized.");
     }
 
-    Log("--- Python Manager initialization successful ---");
+    // Every realization starts with all inputs reported as changed, no cached outputs and empty builders
+    ResetInputChangeTracking(config);
+    ResetTimeSeriesBuilders();
+    for (auto& node : output_nodes) {
+        node.last_value.clear();
+    }
+
+    GSPY_LOG(LOG_INFO, "--- Python Manager initialization successful ---");
     return true;
 }
 
 void FinalizePython() {
     // LOGGING: Announce the start of the cleanup process.
-    LogInfo("--- Finalizing Python Manager ---");
+    GSPY_LOG_INFO("--- Finalizing Python Manager ---");
 
     Py_XDECREF(pFunc);
+    for (auto& node : output_nodes) {
+        Py_XDECREF(node.func);
+    }
+    output_nodes.clear();
+    release_log_sites();
+    Py_CLEAR(log_handler_type);
+    LogLazyInputUsage();
+    ReleaseLazyInputs();
+    ReleaseTimeSeriesResources();
+    ReleaseLookupTableCache();
+    for (PyObject* key : input_name_keys) Py_XDECREF(key);
+    for (PyObject* key : output_name_keys) Py_XDECREF(key);
+    input_name_keys.clear();
+    output_name_keys.clear();
+    Py_XDECREF(empty_args);
+    empty_args = nullptr;
+    Py_XDECREF(record_view);
+    Py_XDECREF(record_descr);
+    record_view = nullptr;
+    record_descr = nullptr;
+    record_view_data = nullptr;
     Py_XDECREF(pModule);
+    ReleaseSharedArrays();
 
     // Clean up the error message pointer
     if (g_python_error_message != nullptr) {
@@ -402,16 +1278,16 @@ void FinalizePython() {
 
     if (Py_IsInitialized()) {
         // LOGGING: Confirm that we are shutting down the interpreter.
-        LogInfo("Shutting down Python interpreter.");
+        GSPY_LOG_INFO("Shutting down Python interpreter.");
         Py_Finalize();
     }
     else {
         // LOGGING: Note if no shutdown was necessary.
-        LogInfo("Python interpreter was not initialized. No cleanup needed.");
+        GSPY_LOG_INFO("Python interpreter was not initialized. No cleanup needed.");
     }
     
     // Log session finish message (can be suppressed by log_level = 0)
-    LogInfo("GSPy session finished successfully");
+    GSPY_LOG_INFO("GSPy session finished successfully");
 }
 
 int GetNumberOfInputs() {
@@ -420,14 +1296,14 @@ int GetNumberOfInputs() {
     int total_inputs = 0;
     for (const auto& input : config["inputs"]) {
         // If any input is a dynamic type, we must return -1.
-        if (input["type"] == "timeseries") {
-            LogDebug("GetNumberOfInputs detected a dynamic time series. Returning -1.");
+        if (is_variable_length(input)) {
+            GSPY_LOG_DEBUG("GetNumberOfInputs detected a dynamic time series or table. Returning -1.");
             return -1;
         }
         total_inputs += calculate_total_elements(input["dimensions"]);
     }
 
-    LogDebug("GetNumberOfInputs calculated a total of: " + std::to_string(total_inputs));
+    GSPY_LOG_DEBUG("GetNumberOfInputs calculated a total of: " + std::to_string(total_inputs));
     return total_inputs;
 }
 
@@ -436,72 +1312,69 @@ int GetNumberOfOutputs() {
 
     int total_outputs = 0;
     for (const auto& output : config["outputs"]) {
-        std::string type = output["type"];
-
-        if (type == "timeseries") {
-            // Your correct, detailed calculation for Time Series
-            int max_points = output.value("max_points", 1);
-            const auto& dims = output["dimensions"];
-            int data_multiplier = 1;
-            // Note: A scalar TS has 0 dims, a vector has 1, a matrix has 2.
-            // The data array shape is (rows, cols, time_points).
-            // data_multiplier here will be rows * cols.
-            if (!dims.empty()) data_multiplier *= dims[0].get<int>(); // rows
-            if (dims.size() > 1) data_multiplier *= dims[1].get<int>(); // cols
-
-            // Total size = 8 metadata doubles + N timestamps + (N * rows * cols) data values
-            total_outputs += 8 + max_points + (max_points * data_multiplier);
-        }
-        else if (type == "table") {
-            // For tables, the structure is more complex, so we rely on the user's max_elements estimate.
-            total_outputs += output.value("max_elements", 1);
-        }
-        else {
-            // Standard calculation for fixed-size arrays (scalar, vector, matrix)
-            total_outputs += calculate_total_elements(output["dimensions"]);
-        }
+        total_outputs += output_length(output);
     }
 
-    LogDebug("GetNumberOfOutputs calculated a total of: " + std::to_string(total_outputs));
+    GSPY_LOG_DEBUG("GetNumberOfOutputs calculated a total of: " + std::to_string(total_outputs));
     return total_outputs;
 }
 
 // --- The ExecuteCalculation function is now a clean, high-level commander ---
+// Microseconds between two phase boundaries, for the flight recorder
+static long long elapsed_us(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+}
+
 void ExecuteCalculation(double* inargs, double* outargs, std::string& errorMessage) {
-    LogInfo("--- Executing Calculation Cycle ---");
-    if (!pFunc) {
+    GSPY_LOG_INFO("--- Executing Calculation Cycle ---");
+    ++calculation_count;
+    if (!pFunc && output_nodes.empty() && all_outputs_from_files()) {
+        // Nothing to compute: copy every file straight into outargs without touching Python
+        double* current_outarg_pointer = outargs;
+        for (const auto& output : config["outputs"]) {
+            WriteOutputSource(output, current_outarg_pointer);
+        }
+        GSPY_LOG_INFO("--- Calculation Cycle Complete ---");
+        return;
+    }
+    if (!pFunc && output_nodes.empty()) {
         errorMessage = "Error: Python function not loaded.";
         LogError(errorMessage);
         return;
     }
 
     // 1. Delegate argument preparation
+    auto phase_start = std::chrono::steady_clock::now();
     PyObject* pArgs = MarshalInputsToPython(config["inputs"], inargs);
     if (!pArgs) {
         errorMessage = "Error: Failed to marshal inputs for Python.";
         LogError(errorMessage);
         return;
     }
+    UpdateInputChanges(inargs, input_slices);
+    auto inputs_done = std::chrono::steady_clock::now();
+
+    // 1.5. Dependency-graph mode: each output has its own function
+    if (!output_nodes.empty()) {
+        bool ok = EvaluateOutputGraph(pArgs, config["outputs"], outargs, errorMessage);
+        EndLazyInputsCall();
+        Py_DECREF(pArgs);
+        GSPY_RECORD_EVENT(GraphTiming, calculation_count, elapsed_us(phase_start, inputs_done),
+                          elapsed_us(inputs_done, std::chrono::steady_clock::now()));
+        if (ok) GSPY_LOG_INFO("--- Calculation Cycle Complete ---");
+        return;
+    }
 
     // 2. Call the Python function
-    LogDebug("Calling Python function...");
-    PyObject* pResultTuple = PyObject_CallObject(pFunc, pArgs);
+    GSPY_LOG_DEBUG("Calling Python function...");
+    PyObject* pResultTuple = CallWithInputs(pFunc, pArgs);
+    EndLazyInputsCall();
     Py_DECREF(pArgs);
+    auto python_done = std::chrono::steady_clock::now();
 
     // 2.5. Check if Python raised an exception (including from gspy.error())
     if (pResultTuple == nullptr) {
-        // Python exception occurred
-        if (g_python_error_message != nullptr && !g_python_error_message->empty()) {
-            // gspy.error() was called - use the stored message
-            errorMessage = "GSPy Error: " + *g_python_error_message;
-            LogDebug("Python signaled fatal error via gspy.error(): " + *g_python_error_message);
-            g_python_error_message->clear();
-        } else {
-            // Some other Python exception - get the error details
-            PyErr_Print();
-            errorMessage = "Python exception occurred (see log for details)";
-            LogError(errorMessage);
-        }
+        HandlePythonCallFailure(errorMessage);
         return;
     }
 
@@ -509,17 +1382,20 @@ void ExecuteCalculation(double* inargs, double* outargs, std::string& errorMessa
     // (This shouldn't happen with the new implementation, but keep as safety check)
     if (g_python_error_message != nullptr && !g_python_error_message->empty()) {
         errorMessage = "GSPy Error: " + *g_python_error_message;
-        LogDebug("Python signaled fatal error: " + errorMessage);
+        GSPY_LOG_DEBUG("Python signaled fatal error: " + errorMessage);
         g_python_error_message->clear();
         Py_DECREF(pResultTuple);
         return;
     }
 
     // 3. Delegate result processing
-    if (!MarshalOutputsToCpp(pResultTuple, config["outputs"], outargs, errorMessage)) {
+    bool outputs_ok = MarshalOutputsToCpp(pResultTuple, config["outputs"], outargs, errorMessage);
+    GSPY_RECORD_EVENT(CalcTiming, calculation_count, elapsed_us(phase_start, inputs_done), elapsed_us(inputs_done, python_done),
+                      elapsed_us(python_done, std::chrono::steady_clock::now()));
+    if (!outputs_ok) {
         // MarshalOutputsToCpp handles its own error logging and Py_DECREF
         return;
     }
 
-    LogInfo("--- Calculation Cycle Complete ---");
+    GSPY_LOG_INFO("--- Calculation Cycle Complete ---");
 }
\ No newline at end of file
@@ -0,0 +1,329 @@
+// Required includes for Python/NumPy
+#ifdef _DEBUG
+    #undef _DEBUG
+    #include <Python.h>
+    #define _DEBUG
+#else
+    #include <Python.h>
+#endif
+
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include "numpy/ndarrayobject.h"
+
+#include "SharedDataManager.h"
+#include "LookupTableManager.h"
+#include "TimeSeriesManager.h"
+#include "Logger.h"
+#include <map>
+#include <vector>
+#include <cstring>
+#include <cmath>
+
+// A memory-mapped dataset. The view keeps the underlying numpy.memmap (and therefore
+// the file mapping) alive, so the OS page cache backs every process that maps the file.
+struct SharedArray {
+    std::string path;
+    PyObject* view = nullptr;
+};
+
+// Cache of mapped datasets keyed by name. This lives for the lifetime of the
+// interpreter, so it survives the XF_INITIALIZE call GoldSim makes before each realization.
+static std::map<std::string, SharedArray> shared_arrays;
+
+// The GoldSim block of an output read from a file. Mapped .npy sources point into the
+// mapping (kept alive by view); .npz sources are laid out once into block.
+struct OutputSource {
+    PyObject* view = nullptr;
+    std::vector<double> block;
+    const double* data = nullptr;
+    size_t length = 0;
+};
+
+// Keyed by the output's config entry, whose address is stable because the config is read once
+static std::map<const nlohmann::json*, OutputSource> output_sources;
+
+static bool ensure_numpy() {
+    static bool numpy_initialized = false;
+    if (!numpy_initialized) {
+        if (_import_array() < 0) {
+            LogError("Error: Could not initialize NumPy C-API in SharedDataManager.");
+            PyErr_Print();
+            return false;
+        }
+        numpy_initialized = true;
+    }
+    return true;
+}
+
+// Maps a .npy file read-only and returns a plain ndarray view over the mapping (new reference).
+static PyObject* map_npy_file(const std::string& path, std::string& errorMessage) {
+    PyObject* pNumpy = PyImport_ImportModule("numpy");
+    if (!pNumpy) {
+        PyErr_Print();
+        errorMessage = "Error: Could not import numpy to map shared array '" + path + "'.";
+        return nullptr;
+    }
+
+    // Equivalent to numpy.load(path, mmap_mode='r'): parses the .npy header and maps the payload
+    PyObject* pMemmap = nullptr;
+    PyObject* pLoad = PyObject_GetAttrString(pNumpy, "load");
+    Py_DECREF(pNumpy);
+    if (pLoad) {
+        PyObject* pArgs = Py_BuildValue("(s)", path.c_str());
+        PyObject* pKwargs = Py_BuildValue("{s:s}", "mmap_mode", "r");
+        pMemmap = PyObject_Call(pLoad, pArgs, pKwargs);
+        Py_DECREF(pArgs);
+        Py_DECREF(pKwargs);
+        Py_DECREF(pLoad);
+    }
+    if (!pMemmap || !PyArray_Check(pMemmap)) {
+        if (PyErr_Occurred()) PyErr_Print();
+        Py_XDECREF(pMemmap);
+        errorMessage = "Error: Could not memory-map shared array file '" + path + "'. Only uncompressed .npy files are supported.";
+        return nullptr;
+    }
+
+    // Hand scripts a base-class ndarray so derived results are not memmap subclasses
+    PyObject* pView = PyArray_View((PyArrayObject*)pMemmap, nullptr, &PyArray_Type);
+    Py_DECREF(pMemmap);
+    if (!pView) {
+        PyErr_Print();
+        errorMessage = "Error: Could not create a view over shared array file '" + path + "'.";
+        return nullptr;
+    }
+    return pView;
+}
+
+// Returns the cached view for name, mapping path on first use (new reference).
+static PyObject* get_shared_array(const std::string& name, const std::string& path, std::string& errorMessage) {
+    auto it = shared_arrays.find(name);
+    if (it != shared_arrays.end()) {
+        if (!path.empty() && path != it->second.path) {
+            errorMessage = "Error: Shared array '" + name + "' is already mapped from '" + it->second.path + "', not '" + path + "'.";
+            return nullptr;
+        }
+        Py_INCREF(it->second.view);
+        return it->second.view;
+    }
+
+    if (path.empty()) {
+        errorMessage = "Error: Shared array '" + name + "' is not declared in 'shared_data' and no path was given.";
+        return nullptr;
+    }
+    if (!ensure_numpy()) {
+        errorMessage = "Error: Could not initialize NumPy C-API in SharedDataManager.";
+        return nullptr;
+    }
+
+    PyObject* pView = map_npy_file(path, errorMessage);
+    if (!pView) return nullptr;
+
+    GSPY_LOG_DEBUG("Shared array '" + name + "' mapped from '" + path + "' (" +
+                   std::to_string(PyArray_NBYTES((PyArrayObject*)pView)) + " bytes).");
+    shared_arrays[name] = SharedArray{ path, pView };
+    Py_INCREF(pView);
+    return pView;
+}
+
+bool PreloadSharedArrays(const nlohmann::json& config, std::string& errorMessage) {
+    if (!config.contains("shared_data")) return true;
+
+    for (const auto& entry : config["shared_data"]) {
+        std::string name = entry["name"];
+        std::string path = entry["path"];
+        PyObject* pView = get_shared_array(name, path, errorMessage);
+        if (!pView) {
+            LogError(errorMessage);
+            return false;
+        }
+        Py_DECREF(pView);
+    }
+    GSPY_LOG_INFO("Pre-mapped " + std::to_string(shared_arrays.size()) + " shared array(s).");
+    return true;
+}
+
+void ReleaseSharedArrays() {
+    for (auto& entry : shared_arrays) {
+        Py_XDECREF(entry.second.view);
+    }
+    shared_arrays.clear();
+    for (auto& entry : output_sources) {
+        Py_XDECREF(entry.second.view);
+    }
+    output_sources.clear();
+}
+
+// Number of doubles the GoldSim sequence in data occupies, or -1 if it is malformed or
+// runs past count. Bounded, unlike the inargs walkers, because the file is not trusted.
+static long raw_sequence_length(const std::string& type, const double* data, size_t count) {
+    long available = static_cast<long>(count);
+    if (type == "table") {
+        long table_dim = available > 0 && data[0] >= 1 && data[0] <= 3 ? static_cast<long>(data[0]) : 0;
+        if (table_dim < 1 || table_dim > 3 || available < 1 + table_dim) return -1;
+        // Sizes below 1, or a value count beyond the buffer, cannot describe a table that fits
+        // in it. Checked in double so a corrupt size cannot overflow the length sum.
+        double data_size = 1;
+        for (long d = 1; d <= table_dim; ++d) {
+            if (!(data[d] >= 1 && data[d] <= available)) return -1;
+            data_size *= std::floor(data[d]);
+        }
+        if (data_size > available) return -1;
+        return GetGoldSimLookupTableLength(data);
+    }
+
+    if (available < 8 || data[0] != 20.0 || data[1] != -3.0) return -1;
+    for (int i = 4; i <= 6; ++i) {
+        if (!(std::fabs(data[i]) <= available)) return -1;
+    }
+    long num_rows = static_cast<long>(data[4]);
+    long num_cols = static_cast<long>(data[5]);
+    long num_series = data[6] < 1 ? 1 : static_cast<long>(data[6]);
+    long length = 7;
+    for (long s = 0; s < num_series; ++s) {
+        // Each series header must lie inside the buffer before it is read, and its point
+        // count must be non-negative and leave the series inside the buffer too.
+        if (length >= available) return -1;
+        double num_time_points = data[length];
+        if (!(num_time_points >= 0 && num_time_points <= available)) return -1;
+        num_time_points = std::floor(num_time_points);
+        double series_size = 1 + num_time_points +
+                             num_time_points * (num_rows > 0 ? num_rows : 1) * (num_cols > 0 ? num_cols : 1);
+        if (series_size > available - length) return -1;
+        length += static_cast<long>(series_size);
+    }
+    return length;
+}
+
+// Loads an .npz archive into a dict and lays it out with the table or time series marshaller.
+static bool layout_archive(const nlohmann::json& output, const std::string& path, long capacity,
+                           std::vector<double>& block, std::string& errorMessage) {
+    PyObject* pNumpy = PyImport_ImportModule("numpy");
+    PyObject* pArchive = pNumpy ? PyObject_CallMethod(pNumpy, "load", "s", path.c_str()) : nullptr;
+    Py_XDECREF(pNumpy);
+    PyObject* pDict = pArchive ? PyDict_New() : nullptr;
+    if (!pDict || PyDict_Merge(pDict, pArchive, 1) < 0) {
+        if (PyErr_Occurred()) PyErr_Print();
+        Py_XDECREF(pDict);
+        Py_XDECREF(pArchive);
+        errorMessage = "Error: Could not read output source archive '" + path + "'.";
+        return false;
+    }
+    PyObject* pClosed = PyObject_CallMethod(pArchive, "close", nullptr);
+    Py_XDECREF(pClosed);
+    PyErr_Clear();
+    Py_DECREF(pArchive);
+
+    // Time series writes are bounded by dimensions, num_series and max_points; tables are not,
+    // so size the scratch block for the worst case (every member is a label or value) and
+    // check afterwards.
+    size_t scratch = static_cast<size_t>(capacity);
+    if (output["type"] == "table") {
+        size_t members = 4;
+        PyObject* key;
+        PyObject* value;
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(pDict, &pos, &key, &value)) {
+            members += PyArray_Check(value) ? static_cast<size_t>(PyArray_SIZE((PyArrayObject*)value)) : 1;
+        }
+        if (members > scratch) scratch = members;
+    }
+    block.assign(scratch, 0.0);
+
+    double* block_end = block.data();
+    bool ok = output["type"] == "table"
+        ? MarshalPythonLookupTableToGoldSim(pDict, output, block_end, errorMessage)
+        : MarshalPythonTimeSeriesToGoldSim(pDict, output, block_end, errorMessage);
+    Py_DECREF(pDict);
+    if (!ok) return false;
+    block.resize(static_cast<size_t>(block_end - block.data()));
+    return true;
+}
+
+bool LoadOutputSource(const nlohmann::json& output, long capacity, std::string& errorMessage) {
+    std::string name = output.value("name", "");
+    std::string type = output["type"];
+    std::string path = output["source"];
+    if (type != "table" && type != "timeseries") {
+        errorMessage = "Error: Output '" + name + "' has a 'source' file, but only table and timeseries outputs can be read from a file.";
+        LogError(errorMessage);
+        return false;
+    }
+    if (!ensure_numpy()) {
+        errorMessage = "Error: Could not initialize NumPy C-API in SharedDataManager.";
+        return false;
+    }
+
+    OutputSource source;
+    bool archive = path.size() >= 4 && path.compare(path.size() - 4, 4, ".npz") == 0;
+    if (archive) {
+        if (!layout_archive(output, path, capacity, source.block, errorMessage)) {
+            LogError(errorMessage);
+            return false;
+        }
+        source.data = source.block.data();
+        source.length = source.block.size();
+    }
+    else {
+        source.view = map_npy_file(path, errorMessage);
+        if (!source.view) {
+            LogError(errorMessage);
+            return false;
+        }
+        PyArrayObject* array = (PyArrayObject*)source.view;
+        source.data = static_cast<const double*>(PyArray_DATA(array));
+        source.length = static_cast<size_t>(PyArray_SIZE(array));
+        if (PyArray_TYPE(array) != NPY_FLOAT64 || !PyArray_IS_C_CONTIGUOUS(array) ||
+            raw_sequence_length(type, source.data, source.length) != static_cast<long>(source.length)) {
+            Py_DECREF(source.view);
+            errorMessage = "Error: Output source '" + path + "' is not a float64 array holding exactly one GoldSim " +
+                           (type == "table" ? std::string("lookup table") : std::string("time series")) + " definition.";
+            LogError(errorMessage);
+            return false;
+        }
+        if (type == "timeseries" &&
+            !CheckTimeSeriesShape(static_cast<long>(source.data[4]), static_cast<long>(source.data[5]), output, errorMessage)) {
+            Py_DECREF(source.view);
+            LogError(errorMessage);
+            return false;
+        }
+    }
+
+    if (source.length > static_cast<size_t>(capacity)) {
+        Py_XDECREF(source.view);
+        errorMessage = "Error: Output source '" + path + "' needs " + std::to_string(source.length) + " values, but output '" +
+                       name + "' reserves " + std::to_string(capacity) + ". Increase 'max_points' or 'max_elements'.";
+        LogError(errorMessage);
+        return false;
+    }
+
+    GSPY_LOG_INFO("Output '" + name + "' is read from '" + path + "' (" + std::to_string(source.length) + " values).");
+    OutputSource& slot = output_sources[&output];
+    Py_XDECREF(slot.view);
+    slot = std::move(source);
+    return true;
+}
+
+void WriteOutputSource(const nlohmann::json& output, double*& current_outarg_pointer) {
+    const OutputSource& source = output_sources[&output];
+    memcpy(current_outarg_pointer, source.data, source.length * sizeof(double));
+    current_outarg_pointer += source.length;
+}
+
+PyObject* PythonSharedArray(PyObject* self, PyObject* args) {
+    const char* name;
+    const char* path = nullptr;
+
+    // Parse arguments: name (required), path (optional if declared in the config)
+    if (!PyArg_ParseTuple(args, "s|z", &name, &path)) {
+        return nullptr;
+    }
+
+    std::string errorMessage;
+    PyObject* pView = get_shared_array(name, path ? path : "", errorMessage);
+    if (!pView) {
+        LogError(errorMessage);
+        PyErr_SetString(PyExc_RuntimeError, errorMessage.c_str());
+        return nullptr;
+    }
+    return pView;
+}
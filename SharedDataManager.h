@@ -0,0 +1,23 @@
+#pragma once
+#include <Python.h>
+#include "json.hpp"
+#include <string>
+
+// Memory-maps every dataset listed under "shared_data" in the config so scripts
+// can fetch them with gspy.shared_array() without paying the load cost.
+bool PreloadSharedArrays(const nlohmann::json& config, std::string& errorMessage);
+
+// Releases all cached shared arrays (and their file mappings). Call before Py_Finalize.
+void ReleaseSharedArrays();
+
+// Python-callable: gspy.shared_array(name, path=None)
+PyObject* PythonSharedArray(PyObject* self, PyObject* args);
+
+// Loads the "source" file of a table or time series output once. An .npz archive holds the
+// same keys the script would return and is laid out by the table/time series marshallers;
+// any other file is a .npy array that already holds the GoldSim sequence and is memory-mapped.
+// capacity is the number of doubles GoldSim reserves for the output.
+bool LoadOutputSource(const nlohmann::json& output, long capacity, std::string& errorMessage);
+
+// Copies the block loaded for output into outargs and advances the pointer.
+void WriteOutputSource(const nlohmann::json& output, double*& current_outarg_pointer);
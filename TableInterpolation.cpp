@@ -0,0 +1,109 @@
+#include "TableInterpolation.h"
+#include <algorithm>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define GSPY_INTERPOLATION_SSE2
+#endif
+
+// Queries are processed in chunks so the corner values and weights of one chunk
+// (8 + 3 rows of 256 doubles, 22 KB) stay in L1 between the search and the blend.
+static const std::size_t chunk_size = 256;
+
+// Returns i such that x lies in [labels[i], labels[i+1]], trying the hint and its neighbours
+// before a binary search. Values outside the labels land in the first or last cell.
+static inline std::size_t find_cell(const double* labels, std::size_t n, double x, std::size_t hint) {
+    if (n < 2) return 0;
+    std::size_t last = n - 2;
+    if (hint > last) hint = last;
+    if (x >= labels[hint]) {
+        if (x <= labels[hint + 1]) return hint;
+        if (hint < last && x <= labels[hint + 2]) return hint + 1;
+    }
+    else if (hint > 0 && x >= labels[hint - 1]) {
+        return hint - 1;
+    }
+    return static_cast<std::size_t>(std::upper_bound(labels + 1, labels + n - 1, x) - labels) - 1;
+}
+
+void Lerp(const double* a, const double* b, const double* w, double* out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 4 <= n; i += 4) {
+        __m256d va = _mm256_loadu_pd(a + i);
+        __m256d diff = _mm256_sub_pd(_mm256_loadu_pd(b + i), va);
+        _mm256_storeu_pd(out + i, _mm256_add_pd(va, _mm256_mul_pd(_mm256_loadu_pd(w + i), diff)));
+    }
+#elif defined(GSPY_INTERPOLATION_SSE2)
+    for (; i + 2 <= n; i += 2) {
+        __m128d va = _mm_loadu_pd(a + i);
+        __m128d diff = _mm_sub_pd(_mm_loadu_pd(b + i), va);
+        _mm_storeu_pd(out + i, _mm_add_pd(va, _mm_mul_pd(_mm_loadu_pd(w + i), diff)));
+    }
+#endif
+    for (; i < n; ++i) out[i] = a[i] + w[i] * (b[i] - a[i]);
+}
+
+void InterpolateTable(const double* table, const double* const* coords, const std::size_t* coord_steps,
+                      std::size_t count, double* results, std::size_t* hints) {
+    std::size_t dim = static_cast<std::size_t>(table[0]);
+    std::size_t sizes[3] = { 1, 1, 1 };
+    const double* labels[3] = {};
+    const double* p = table + 1 + dim;
+    for (std::size_t d = 0; d < dim; ++d) {
+        sizes[d] = static_cast<std::size_t>(table[1 + d]);
+        labels[d] = p;
+        p += sizes[d];
+    }
+    const double* values = p;
+
+    // Distance between neighbouring values along each axis: rows are cols apart, columns are
+    // adjacent and layers are a whole rows x cols slice apart
+    std::size_t steps[3] = { dim > 1 ? sizes[1] : 1, 1, sizes[0] * sizes[1] };
+
+    // Offset of each cell corner from the cell's lower corner; bit d of a corner index selects
+    // the upper neighbour along axis d (the same neighbour on single-label axes)
+    std::size_t corners = std::size_t(1) << dim;
+    std::size_t corner_offsets[8] = {};
+    for (std::size_t k = 0; k < corners; ++k) {
+        for (std::size_t d = 0; d < dim; ++d) {
+            if ((k >> d & 1) && sizes[d] > 1) corner_offsets[k] += steps[d];
+        }
+    }
+
+    double corner_values[8][chunk_size];
+    double weights[3][chunk_size];
+
+    for (std::size_t start = 0; start < count; start += chunk_size) {
+        std::size_t n = std::min(chunk_size, count - start);
+
+        // Bracket search: one cell and weight per axis, then gather the 2^dim corner values
+        for (std::size_t q = 0; q < n; ++q) {
+            std::size_t base = 0;
+            for (std::size_t d = 0; d < dim; ++d) {
+                double x = coords[d][(start + q) * coord_steps[d]];
+                std::size_t cell = find_cell(labels[d], sizes[d], x, hints[d]);
+                hints[d] = cell;
+                double w = 0.0;
+                if (sizes[d] > 1) {
+                    w = (x - labels[d][cell]) / (labels[d][cell + 1] - labels[d][cell]);
+                    w = w < 0.0 ? 0.0 : (w > 1.0 ? 1.0 : w);
+                }
+                weights[d][q] = w;
+                base += cell * steps[d];
+            }
+            const double* cell_values = values + base;
+            for (std::size_t k = 0; k < corners; ++k) corner_values[k][q] = cell_values[corner_offsets[k]];
+        }
+
+        // Blend: collapse the last axis first, halving the corners each time
+        for (std::size_t axis = dim; axis-- > 0;) {
+            std::size_t half = std::size_t(1) << axis;
+            for (std::size_t k = 0; k < half; ++k) {
+                Lerp(corner_values[k], corner_values[k + half], weights[axis], axis == 0 ? results + start : corner_values[k], n);
+            }
+        }
+    }
+}
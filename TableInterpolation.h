@@ -0,0 +1,14 @@
+#pragma once
+#include <cstddef>
+
+// Multilinear interpolation in a GoldSim lookup table sequence (dimension count, sizes, labels,
+// then the values, 3D values layer by layer) at count query points. coords[d] holds the
+// coordinates along dimension d, coord_steps[d] apart (0 broadcasts a single value). Queries
+// outside the labels are clamped to the edge of the table.
+// hints holds the last cell index per dimension and is updated, so queries that move slowly
+// between calls find their cell without a search.
+void InterpolateTable(const double* table, const double* const* coords, const std::size_t* coord_steps,
+                      std::size_t count, double* results, std::size_t* hints);
+
+// out[i] = a[i] + w[i] * (b[i] - a[i]) with SSE2/AVX; out may alias a
+void Lerp(const double* a, const double* b, const double* w, double* out, std::size_t n);
@@ -0,0 +1,81 @@
+#include "TableTranspose.h"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define GSPY_TRANSPOSE_SSE2
+#endif
+
+// 32 x 32 doubles per tile: one source tile plus one destination tile is 16 KB, which fits
+// in L1 alongside the loop state on every x64 CPU GoldSim runs on.
+static const std::size_t tile_size = 32;
+
+#if defined(__AVX__)
+static const std::size_t block_size = 4;
+
+// 4 x 4 register transpose: four row loads, two rounds of shuffles, four column stores
+static inline void transpose_block(const double* src, std::size_t src_stride, double* dst, std::size_t dst_stride) {
+    __m256d r0 = _mm256_loadu_pd(src);
+    __m256d r1 = _mm256_loadu_pd(src + src_stride);
+    __m256d r2 = _mm256_loadu_pd(src + 2 * src_stride);
+    __m256d r3 = _mm256_loadu_pd(src + 3 * src_stride);
+
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1); // r0[0] r1[0] r0[2] r1[2]
+    __m256d t1 = _mm256_unpackhi_pd(r0, r1); // r0[1] r1[1] r0[3] r1[3]
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+    _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(dst + dst_stride, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(dst + 2 * dst_stride, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(dst + 3 * dst_stride, _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+#elif defined(GSPY_TRANSPOSE_SSE2)
+static const std::size_t block_size = 2;
+
+// 2 x 2 register transpose with unpack shuffles (SSE2 is the x64 baseline)
+static inline void transpose_block(const double* src, std::size_t src_stride, double* dst, std::size_t dst_stride) {
+    __m128d r0 = _mm_loadu_pd(src);
+    __m128d r1 = _mm_loadu_pd(src + src_stride);
+    _mm_storeu_pd(dst, _mm_unpacklo_pd(r0, r1));
+    _mm_storeu_pd(dst + dst_stride, _mm_unpackhi_pd(r0, r1));
+}
+#else
+static const std::size_t block_size = 1;
+
+static inline void transpose_block(const double* src, std::size_t, double* dst, std::size_t) {
+    *dst = *src;
+}
+#endif
+
+// Transposes the tile [row_begin, row_end) x [col_begin, col_end)
+static void transpose_tile(const double* src, double* dst, std::size_t rows, std::size_t cols,
+                           std::size_t row_begin, std::size_t row_end, std::size_t col_begin, std::size_t col_end) {
+    std::size_t row_blocks_end = row_begin + (row_end - row_begin) / block_size * block_size;
+    std::size_t col_blocks_end = col_begin + (col_end - col_begin) / block_size * block_size;
+
+    for (std::size_t r = row_begin; r < row_blocks_end; r += block_size) {
+        for (std::size_t c = col_begin; c < col_blocks_end; c += block_size) {
+            transpose_block(src + r * cols + c, cols, dst + c * rows + r, rows);
+        }
+        // Columns left over after the last full register block
+        for (std::size_t c = col_blocks_end; c < col_end; ++c) {
+            for (std::size_t k = r; k < r + block_size; ++k) dst[c * rows + k] = src[k * cols + c];
+        }
+    }
+    // Rows left over after the last full register block
+    for (std::size_t r = row_blocks_end; r < row_end; ++r) {
+        for (std::size_t c = col_begin; c < col_end; ++c) dst[c * rows + r] = src[r * cols + c];
+    }
+}
+
+void TransposeMatrix(const double* src, double* dst, std::size_t rows, std::size_t cols) {
+    for (std::size_t r = 0; r < rows; r += tile_size) {
+        std::size_t row_end = r + tile_size < rows ? r + tile_size : rows;
+        for (std::size_t c = 0; c < cols; c += tile_size) {
+            std::size_t col_end = c + tile_size < cols ? c + tile_size : cols;
+            transpose_tile(src, dst, rows, cols, r, row_end, c, col_end);
+        }
+    }
+}
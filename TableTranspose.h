@@ -0,0 +1,7 @@
+#pragma once
+#include <cstddef>
+
+// Transposes a row-major rows x cols matrix of doubles into dst (cols x rows, row-major).
+// Works in cache-sized tiles with SSE2/AVX register transposes inside each tile, so both
+// the reads and the writes stay sequential within a tile. src and dst must not overlap.
+void TransposeMatrix(const double* src, double* dst, std::size_t rows, std::size_t cols);
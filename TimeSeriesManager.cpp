@@ -10,95 +10,1044 @@
 
 #include "TimeSeriesManager.h"
 #include "Logger.h"
+#include "BinaryLog.h"
+#include "TableInterpolation.h"
 #include <vector>
 #include <numpy/arrayobject.h>
 #include <sstream>
+#include <cstring>
+#include <algorithm>
+#include <cmath>
 
+// Last definition block and Python object for each cached time series input
+struct CachedTimeSeriesInput {
+    PyObject* storage = nullptr;  // read-only float64 copy of the block the value views
+    PyObject* value = nullptr;
+};
+static std::vector<CachedTimeSeriesInput> ts_input_cache;
 
-PyObject* MarshalGoldSimTimeSeriesToPython(double*& current_inarg_pointer, const nlohmann::json& config) {
-    // Initialize NumPy API, but only once.
+// Initialize NumPy API, but only once.
+static bool ensure_numpy() {
     static bool numpy_initialized = false;
     if (!numpy_initialized) {
         if (_import_array() < 0) {
             LogError("Error: Could not initialize NumPy C-API in TimeSeriesManager.");
             PyErr_Print();
-            // We can't send an error here easily, so we'll return None and let the Python call fail.
-            Py_INCREF(Py_None);
-            return Py_None;
+            return false;
         }
         numpy_initialized = true;
     }
-    Log("--- TimeSeriesManager: Marshalling GoldSim Time Series to Python ---");
+    return true;
+}
+
+// Shape of a time series and where consecutive series sit in memory. Strides are in doubles.
+// GoldSim repeats (point count, timestamps, values) for every series, so a definition block
+// can be described with one stride per array and viewed without copying.
+struct SeriesLayout {
+    npy_intp num_series = 1;
+    npy_intp num_time_points = 0;
+    npy_intp num_rows = 0;          // 0 for scalar time series
+    npy_intp num_cols = 0;          // 0 for scalar and vector time series
+    npy_intp timestamps_stride = 0; // 0 when all series share one timestamp array
+    npy_intp data_stride = 0;
+};
+
+// Values per series: rows * cols * time points
+static npy_intp series_size(const SeriesLayout& layout) {
+    npy_intp size = layout.num_time_points;
+    if (layout.num_rows > 0) size *= layout.num_rows;
+    if (layout.num_cols > 0) size *= layout.num_cols;
+    return size;
+}
+
+// NumPy shape of the data: (series, rows, cols, time), with series only present when
+// num_series > 1 and rows/cols dropped when GoldSim reports them as 0.
+static int data_shape(const SeriesLayout& layout, npy_intp* dims) {
+    int ndim = 0;
+    if (layout.num_series > 1) dims[ndim++] = layout.num_series;
+    if (layout.num_rows > 0) dims[ndim++] = layout.num_rows;
+    if (layout.num_cols > 0) dims[ndim++] = layout.num_cols;
+    dims[ndim++] = layout.num_time_points;
+    return ndim;
+}
+
+// Fills layout from a timestamps/data array pair with time as the last data axis.
+// Timestamps are either shared (1-D) or per series (2-D, one row per series).
+static bool describe_series_arrays(PyArrayObject* timestamps, PyArrayObject* data, npy_intp num_series, SeriesLayout& layout, std::string& errorMessage) {
+    int ts_ndim = PyArray_NDIM(timestamps);
+    if (ts_ndim == 2) num_series = PyArray_DIM(timestamps, 0);
+    else if (ts_ndim != 1) {
+        errorMessage = "Error: timestamps must be 1-D, or 2-D with one row per series.";
+        return false;
+    }
+    if (num_series < 1) num_series = 1;
+
+    layout.num_series = num_series;
+    layout.num_time_points = PyArray_DIM(timestamps, ts_ndim - 1);
+
+    int ndim = PyArray_NDIM(data);
+    int series_axis = num_series > 1 ? 1 : 0;
+    int inner_ndim = ndim - series_axis;
+    if (inner_ndim < 1 || inner_ndim > 3) {
+        errorMessage = "Error: Unsupported array dimensions: " + std::to_string(ndim);
+        return false;
+    }
+    if (series_axis && PyArray_DIM(data, 0) != num_series) {
+        errorMessage = "Error: Time series data has " + std::to_string(PyArray_DIM(data, 0)) + " series but " +
+                       std::to_string(num_series) + " were expected.";
+        return false;
+    }
+    if (PyArray_DIM(data, ndim - 1) != layout.num_time_points) {
+        errorMessage = "Error: The last axis of time series data must match the number of timestamps (" +
+                       std::to_string(layout.num_time_points) + ").";
+        return false;
+    }
+    layout.num_rows = inner_ndim > 1 ? PyArray_DIM(data, series_axis) : 0;
+    layout.num_cols = inner_ndim > 2 ? PyArray_DIM(data, series_axis + 1) : 0;
+    layout.timestamps_stride = ts_ndim == 2 ? layout.num_time_points : 0;
+    layout.data_stride = series_size(layout);
+    return true;
+}
+
+// =================================================================
+// gspy.TimeSeries: native replacement for the time series dictionary
+// =================================================================
+
+// Fields live in C slots. The NumPy views over timestamps and data are only created
+// when the script first asks for them; the output path reads the raw pointers directly.
+struct TimeSeriesObject {
+    PyObject_HEAD
+    double time_basis;
+    double data_type;
+    SeriesLayout layout;
+    double* timestamps_ptr;  // First series; later series follow at layout strides
+    double* data_ptr;
+    PyObject* storage;       // Owns the memory behind the pointers; nullptr when borrowing inargs
+    bool readonly;
+    PyObject* timestamps;    // Lazily created views (or the arrays passed to the constructor)
+    PyObject* data;
+};
+
+static PyObject* time_series_type = nullptr;
+static PyObject* time_series_builder_type = nullptr;
+
+// Wraps ptr in an ndarray whose lifetime is tied to the storage object, if any. Axes after
+// the first are C-contiguous; a leading series axis steps by series_stride doubles.
+static PyObject* make_view(TimeSeriesObject* ts, double* ptr, int ndim, npy_intp* dims, npy_intp series_stride) {
+    if (!ensure_numpy()) return nullptr;
+    npy_intp strides[4];
+    npy_intp step = sizeof(double);
+    for (int i = ndim - 1; i >= 0; --i) {
+        strides[i] = step;
+        step *= dims[i];
+    }
+    if (ts->layout.num_series > 1 && ndim > 1) strides[0] = series_stride * sizeof(double);
+
+    PyObject* view = PyArray_New(&PyArray_Type, ndim, dims, NPY_FLOAT64, strides, ptr, 0, NPY_ARRAY_WRITEABLE | NPY_ARRAY_ALIGNED, nullptr);
+    if (view == nullptr) return nullptr;
+    if (ts->storage != nullptr) {
+        Py_INCREF(ts->storage);
+        PyArray_SetBaseObject((PyArrayObject*)view, ts->storage); // Steals reference to storage
+    }
+    if (ts->readonly) {
+        PyArray_CLEARFLAGS((PyArrayObject*)view, NPY_ARRAY_WRITEABLE);
+    }
+    return view;
+}
+
+static PyObject* ts_get_timestamps(PyObject* self, void*) {
+    TimeSeriesObject* ts = (TimeSeriesObject*)self;
+    if (ts->timestamps == nullptr) {
+        const SeriesLayout& layout = ts->layout;
+        npy_intp dims[2] = { layout.num_series, layout.num_time_points };
+        bool per_series = layout.num_series > 1 && layout.timestamps_stride != 0;
+        ts->timestamps = per_series ? make_view(ts, ts->timestamps_ptr, 2, dims, layout.timestamps_stride)
+                                    : make_view(ts, ts->timestamps_ptr, 1, dims + 1, 0);
+        if (ts->timestamps == nullptr) return nullptr;
+    }
+    Py_INCREF(ts->timestamps);
+    return ts->timestamps;
+}
+
+static PyObject* ts_get_data(PyObject* self, void*) {
+    TimeSeriesObject* ts = (TimeSeriesObject*)self;
+    if (ts->data == nullptr) {
+        npy_intp dims[4];
+        int ndim = data_shape(ts->layout, dims);
+        ts->data = make_view(ts, ts->data_ptr, ndim, dims, ts->layout.data_stride);
+        if (ts->data == nullptr) return nullptr;
+    }
+    Py_INCREF(ts->data);
+    return ts->data;
+}
+
+static PyObject* ts_get_time_basis(PyObject* self, void*) {
+    return PyFloat_FromDouble(((TimeSeriesObject*)self)->time_basis);
+}
+
+static PyObject* ts_get_data_type(PyObject* self, void*) {
+    return PyFloat_FromDouble(((TimeSeriesObject*)self)->data_type);
+}
+
+static PyObject* ts_get_num_series(PyObject* self, void*) {
+    return PyLong_FromSsize_t(((TimeSeriesObject*)self)->layout.num_series);
+}
+
+static PyGetSetDef ts_getset[] = {
+    {"timestamps", ts_get_timestamps, nullptr, "Time points: 1-D, or (series, time) when each series has its own", nullptr},
+    {"data", ts_get_data, nullptr, "Values with time as the last axis and series as the first (if more than one)", nullptr},
+    {"time_basis", ts_get_time_basis, nullptr, "GoldSim time basis code", nullptr},
+    {"data_type", ts_get_data_type, nullptr, "GoldSim data type code", nullptr},
+    {"num_series", ts_get_num_series, nullptr, "Number of series in the definition", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+// Keys of the mapping interface, matching the dictionary format used before gspy.TimeSeries
+static const char* ts_keys[] = { "time_basis", "data_type", "timestamps", "data", "num_series" };
+static const int ts_key_count = 5;
+
+static int ts_contains(PyObject*, PyObject* key) {
+    if (!PyUnicode_Check(key)) return 0;
+    for (int i = 0; i < ts_key_count; ++i) {
+        if (PyUnicode_CompareWithASCIIString(key, ts_keys[i]) == 0) return 1;
+    }
+    return 0;
+}
+
+static PyObject* ts_subscript(PyObject* self, PyObject* key) {
+    if (ts_contains(self, key)) {
+        return PyObject_GenericGetAttr(self, key);
+    }
+    PyErr_SetObject(PyExc_KeyError, key);
+    return nullptr;
+}
+
+static Py_ssize_t ts_length(PyObject*) {
+    return ts_key_count;
+}
+
+static PyObject* ts_keys_method(PyObject*, PyObject*) {
+    return Py_BuildValue("[sssss]", ts_keys[0], ts_keys[1], ts_keys[2], ts_keys[3], ts_keys[4]);
+}
+
+static PyObject* ts_get_method(PyObject* self, PyObject* args) {
+    PyObject* key;
+    PyObject* default_value = Py_None;
+    if (!PyArg_ParseTuple(args, "O|O", &key, &default_value)) return nullptr;
+    if (ts_contains(self, key)) return ts_subscript(self, key);
+    Py_INCREF(default_value);
+    return default_value;
+}
+
+// values() and items() as lists, like keys()
+static PyObject* ts_mapping_list(PyObject* self, bool with_keys) {
+    PyObject* list = PyList_New(ts_key_count);
+    for (int i = 0; list != nullptr && i < ts_key_count; ++i) {
+        PyObject* value = PyObject_GetAttrString(self, ts_keys[i]);
+        PyObject* entry = value != nullptr && with_keys ? Py_BuildValue("(sN)", ts_keys[i], value) : value;
+        if (entry == nullptr) {
+            Py_CLEAR(list);
+            break;
+        }
+        PyList_SET_ITEM(list, i, entry);  // Steals reference to entry
+    }
+    return list;
+}
+
+static PyObject* ts_values_method(PyObject* self, PyObject*) {
+    return ts_mapping_list(self, false);
+}
+
+static PyObject* ts_items_method(PyObject* self, PyObject*) {
+    return ts_mapping_list(self, true);
+}
+
+// Iterating a time series yields its keys, as iterating the dictionary did
+static PyObject* ts_iter(PyObject* self) {
+    PyObject* keys = ts_keys_method(self, nullptr);
+    if (keys == nullptr) return nullptr;
+    PyObject* iter = PyObject_GetIter(keys);
+    Py_DECREF(keys);
+    return iter;
+}
+
+static PyMethodDef ts_methods[] = {
+    {"keys", ts_keys_method, METH_NOARGS, "Keys of the legacy time series dictionary format"},
+    {"values", ts_values_method, METH_NOARGS, "Values in keys() order"},
+    {"items", ts_items_method, METH_NOARGS, "(key, value) pairs in keys() order"},
+    {"get", ts_get_method, METH_VARARGS, "Dictionary-style get(key, default=None)"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+static PyObject* ts_repr(PyObject* self) {
+    TimeSeriesObject* ts = (TimeSeriesObject*)self;
+    npy_intp dims[4];
+    int ndim = data_shape(ts->layout, dims);
+    std::string shape;
+    for (int i = 0; i < ndim; ++i) shape += (i ? ", " : "") + std::to_string(dims[i]);
+    if (ndim == 1) shape += ",";
+    return PyUnicode_FromFormat("gspy.TimeSeries(series=%zd, points=%zd, shape=(%s))", (Py_ssize_t)ts->layout.num_series,
+                                (Py_ssize_t)ts->layout.num_time_points, shape.c_str());
+}
+
+// Creates a gspy.TimeSeries that holds C-contiguous float64 arrays described by layout.
+// Steals the references to timestamps and data.
+static PyObject* wrap_time_series_arrays(PyTypeObject* type, double time_basis, double data_type, const SeriesLayout& layout,
+                                         PyObject* timestamps, PyObject* data) {
+    TimeSeriesObject* ts = (TimeSeriesObject*)type->tp_alloc(type, 0);
+    if (ts == nullptr) {
+        Py_DECREF(timestamps);
+        Py_DECREF(data);
+        return nullptr;
+    }
+    ts->time_basis = time_basis;
+    ts->data_type = data_type;
+    ts->layout = layout;
+    ts->timestamps = timestamps;
+    ts->data = data;
+    ts->timestamps_ptr = (double*)PyArray_DATA((PyArrayObject*)timestamps);
+    ts->data_ptr = (double*)PyArray_DATA((PyArrayObject*)data);
+    return (PyObject*)ts;
+}
+
+// gspy.TimeSeries(timestamps, data, time_basis=0.0, data_type=0.0, num_series=1)
+static PyObject* ts_new(PyTypeObject* type, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = { "timestamps", "data", "time_basis", "data_type", "num_series", nullptr };
+    PyObject* py_timestamps;
+    PyObject* py_data;
+    double time_basis = 0.0;
+    double data_type = 0.0;
+    Py_ssize_t num_series = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|ddn", (char**)kwlist, &py_timestamps, &py_data, &time_basis, &data_type, &num_series)) {
+        return nullptr;
+    }
+    if (!ensure_numpy()) return nullptr;
+
+    PyObject* timestamps = PyArray_FROM_OTF(py_timestamps, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+    PyObject* data = timestamps ? PyArray_FROM_OTF(py_data, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY) : nullptr;
+    if (data == nullptr) {
+        Py_XDECREF(timestamps);
+        return nullptr;
+    }
+
+    SeriesLayout layout;
+    std::string errorMessage;
+    if (!describe_series_arrays((PyArrayObject*)timestamps, (PyArrayObject*)data, num_series, layout, errorMessage)) {
+        PyErr_SetString(PyExc_ValueError, errorMessage.c_str());
+        Py_DECREF(timestamps);
+        Py_DECREF(data);
+        return nullptr;
+    }
+
+    return wrap_time_series_arrays(type, time_basis, data_type, layout, timestamps, data);
+}
+
+static void ts_dealloc(PyObject* self) {
+    TimeSeriesObject* ts = (TimeSeriesObject*)self;
+    Py_XDECREF(ts->timestamps);
+    Py_XDECREF(ts->data);
+    Py_XDECREF(ts->storage);
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+static PyType_Slot time_series_slots[] = {
+    {Py_tp_new, (void*)ts_new},
+    {Py_tp_dealloc, (void*)ts_dealloc},
+    {Py_tp_repr, (void*)ts_repr},
+    {Py_tp_getset, (void*)ts_getset},
+    {Py_tp_methods, (void*)ts_methods},
+    {Py_mp_subscript, (void*)ts_subscript},
+    {Py_mp_length, (void*)ts_length},
+    {Py_sq_contains, (void*)ts_contains},
+    {Py_tp_iter, (void*)ts_iter},
+    {Py_tp_doc, (void*)"GoldSim time series: timestamps, data (time as last axis), time_basis and data_type."},
+    {0, nullptr}
+};
+
+static PyType_Spec time_series_spec = {
+    "gspy.TimeSeries",
+    sizeof(TimeSeriesObject),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    time_series_slots
+};
+
+static bool ensure_time_series_type() {
+    if (time_series_type == nullptr) {
+        time_series_type = PyType_FromSpec(&time_series_spec);
+        if (time_series_type == nullptr) {
+            LogError("Error: Could not create the gspy.TimeSeries type.");
+            PyErr_Print();
+            return false;
+        }
+    }
+    return true;
+}
+
+// A gspy.TimeSeries over series data starting at `series` (the point count of the first
+// series). storage (if any) is the object that owns that memory.
+static PyObject* new_time_series_view(const SeriesLayout& layout, double time_basis, double data_type, double* series, PyObject* storage) {
+    PyTypeObject* type = (PyTypeObject*)time_series_type;
+    TimeSeriesObject* ts = (TimeSeriesObject*)type->tp_alloc(type, 0);
+    if (ts == nullptr) return nullptr;
+    ts->time_basis = time_basis;
+    ts->data_type = data_type;
+    ts->layout = layout;
+    ts->storage = storage;
+    Py_XINCREF(storage);
+    ts->readonly = storage != nullptr;
+
+    // Timestamps come first, followed by the values
+    ts->timestamps_ptr = series + 1;
+    ts->data_ptr = series + 1 + layout.num_time_points;
+    return (PyObject*)ts;
+}
+
+// Series with different point counts cannot share one (series, ..., time) view, so the
+// script gets a tuple with one single-series gspy.TimeSeries per series instead
+static PyObject* ragged_time_series(const SeriesLayout& shape, double time_basis, double data_type, double* series, PyObject* storage) {
+    PyObject* tuple = PyTuple_New(shape.num_series);
+    if (tuple == nullptr) return nullptr;
+    for (npy_intp s = 0; s < shape.num_series; ++s) {
+        SeriesLayout layout = shape;
+        layout.num_series = 1;
+        layout.num_time_points = static_cast<long>(*series);
+        npy_intp block_length = 1 + layout.num_time_points + series_size(layout);
+        layout.timestamps_stride = block_length;
+        layout.data_stride = block_length;
+
+        PyObject* ts = new_time_series_view(layout, time_basis, data_type, series, storage);
+        if (ts == nullptr) {
+            Py_DECREF(tuple);
+            return nullptr;
+        }
+        PyTuple_SET_ITEM(tuple, s, ts);  // Steals reference to ts
+        series += block_length;
+    }
+    GSPY_LOG_DEBUG("  TS Marshalling: Series have different point counts; created a tuple of " + std::to_string(shape.num_series) + " gspy.TimeSeries.");
+    return tuple;
+}
+
+// Parses one GoldSim Time Series Definition into a gspy.TimeSeries (or, for series of
+// different lengths, a tuple of them). The object points
+// straight at the definition; storage (if any) is the object that owns that memory.
+static PyObject* time_series_from_definition(double*& current_inarg_pointer, PyObject* storage) {
+    double* ts_start = current_inarg_pointer;
+    current_inarg_pointer += GetGoldSimTimeSeriesLength(ts_start);
+
+    if (!ensure_numpy() || !ensure_time_series_type()) {
+        // We can't send an error here easily, so we'll return None and let the Python call fail.
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+    GSPY_LOG(LOG_INFO, "--- TimeSeriesManager: Marshalling GoldSim Time Series to Python ---");
 
     // We will now log every piece of metadata we read from the data stream.
-    double ts_id = *current_inarg_pointer++;
-    LogDebug("  TS Metadata: ts_id = " + std::to_string(ts_id));
+    double* p = ts_start;
+    double ts_id = *p++;
+    GSPY_LOG_EVENT(TsMetadata, "ts_id", ts_id);
+
+    double format_version = *p++;
+    GSPY_LOG_EVENT(TsMetadata, "format_version", format_version);
+
+    double time_basis = *p++;
+    GSPY_LOG_EVENT(TsMetadata, "time_basis", time_basis);
+
+    double data_type = *p++;
+    GSPY_LOG_EVENT(TsMetadata, "data_type", data_type);
 
-    double format_version = *current_inarg_pointer++;
-    LogDebug("  TS Metadata: format_version = " + std::to_string(format_version));
+    long num_rows = static_cast<long>(*p++);
+    GSPY_LOG_EVENT(TsMetadata, "num_rows", num_rows);
 
-    double time_basis = *current_inarg_pointer++;
-    LogDebug("  TS Metadata: time_basis = " + std::to_string(time_basis));
+    long num_cols = static_cast<long>(*p++);
+    GSPY_LOG_EVENT(TsMetadata, "num_cols", num_cols);
 
-    double data_type = *current_inarg_pointer++;
-    LogDebug("  TS Metadata: data_type = " + std::to_string(data_type));
+    long num_series = static_cast<long>(*p++);
+    GSPY_LOG_EVENT(TsMetadata, "num_series", num_series);
 
-    long num_rows = static_cast<long>(*current_inarg_pointer++);
-    LogDebug("  TS Metadata: num_rows = " + std::to_string(num_rows));
+    long num_time_points = static_cast<long>(*p);
+    GSPY_LOG_EVENT(TsMetadata, "num_time_points", num_time_points);
 
-    long num_cols = static_cast<long>(*current_inarg_pointer++);
-    LogDebug("  TS Metadata: num_cols = " + std::to_string(num_cols));
+    SeriesLayout layout;
+    layout.num_series = num_series > 1 ? num_series : 1;
+    layout.num_time_points = num_time_points;
+    layout.num_rows = num_rows > 0 ? num_rows : 0;
+    layout.num_cols = num_cols > 0 ? num_cols : 0;
 
-    long num_series = static_cast<long>(*current_inarg_pointer++);
-    LogDebug("  TS Metadata: num_series = " + std::to_string(num_series));
+    // Each series is (point count, timestamps, values). A single (series, ..., time) view
+    // needs every series to have the same point count, which makes the series stride constant.
+    npy_intp block_length = 1 + num_time_points + series_size(layout);
+    bool ragged = false;
+    for (npy_intp s = 1; s < layout.num_series && !ragged; ++s) {
+        ragged = static_cast<long>(p[s * block_length]) != num_time_points;
+    }
+    if (ragged) {
+        return ragged_time_series(layout, time_basis, data_type, p, storage);
+    }
+    layout.timestamps_stride = block_length;
+    layout.data_stride = block_length;
 
-    long num_time_points = static_cast<long>(*current_inarg_pointer++);
-    LogDebug("  TS Metadata: num_time_points = " + std::to_string(num_time_points));
+    PyObject* ts = new_time_series_view(layout, time_basis, data_type, p, storage);
+    if (ts != nullptr) GSPY_LOG_DEBUG("  TS Marshalling: Successfully created gspy.TimeSeries.");
+    return ts;
+}
 
-    // Create a NumPy array for the timestamps by wrapping the data pointer (no copy)
-    npy_intp time_dims[] = { num_time_points };
-    PyObject* py_timestamps = PyArray_SimpleNewFromData(1, time_dims, NPY_FLOAT64, current_inarg_pointer);
+PyObject* MarshalGoldSimTimeSeriesToPython(double*& current_inarg_pointer, const nlohmann::json& config) {
+    // Zero-copy: the object borrows inargs for the duration of the call
+    return time_series_from_definition(current_inarg_pointer, nullptr);
+}
 
-    // Advance the pointer PAST the timestamp data BEFORE reading the value data.
-    current_inarg_pointer += num_time_points;
+long GetGoldSimTimeSeriesLength(const double* ts_start) {
+    // Header layout matches MarshalGoldSimTimeSeriesToPython: rows, cols and series count
+    // sit at offsets 4, 5 and 6, then each series starts with its own point count.
+    long num_rows = static_cast<long>(ts_start[4]);
+    long num_cols = static_cast<long>(ts_start[5]);
+    long num_series = static_cast<long>(ts_start[6]);
+    if (num_series < 1) num_series = 1;
 
-    // Create a NumPy array for the data values
-    long data_size = num_time_points;
-    std::vector<npy_intp> data_dims_vec;
-    data_dims_vec.push_back(num_time_points);
+    long length = 7;
+    for (long s = 0; s < num_series; ++s) {
+        long num_time_points = static_cast<long>(ts_start[length]);
+        long data_size = num_time_points;
+        if (num_cols > 0) data_size *= num_cols;
+        if (num_rows > 0) data_size *= num_rows;
+        length += 1 + num_time_points + data_size;
+    }
+    return length;
+}
 
-    // Insert dimensions to match the expected shape in MarshalPythonTimeSeriesToGoldSim
-    // Final shape should be (num_rows, num_cols, num_time_points)
-    if (num_cols > 0) {
-        data_dims_vec.insert(data_dims_vec.begin(), num_cols);
-        data_size *= num_cols;
+PyObject* MarshalCachedGoldSimTimeSeriesToPython(double* ts_start, size_t slot, const nlohmann::json& config) {
+    long length = GetGoldSimTimeSeriesLength(ts_start);
+    if (slot >= ts_input_cache.size()) ts_input_cache.resize(slot + 1);
+    CachedTimeSeriesInput& entry = ts_input_cache[slot];
+
+    // Header and payload unchanged: hand back the very same object
+    if (entry.value != nullptr && PyArray_SIZE((PyArrayObject*)entry.storage) == length &&
+        memcmp(PyArray_DATA((PyArrayObject*)entry.storage), ts_start, length * sizeof(double)) == 0) {
+        Py_INCREF(entry.value);
+        return entry.value;
     }
-    if (num_rows > 0) {
-        data_dims_vec.insert(data_dims_vec.begin(), num_rows);
-        data_size *= num_rows;
+    if (!ensure_numpy()) {
+        Py_INCREF(Py_None);
+        return Py_None;
     }
 
-    PyObject* py_data = PyArray_SimpleNewFromData(static_cast<int>(data_dims_vec.size()), data_dims_vec.data(), NPY_FLOAT64, current_inarg_pointer);
+    // inargs is reused by GoldSim, so the cached object gets its own read-only copy of the block
+    npy_intp block_dims[] = { length };
+    PyObject* storage = PyArray_SimpleNew(1, block_dims, NPY_FLOAT64);
+    if (storage == nullptr) return nullptr;
+    double* block = (double*)PyArray_DATA((PyArrayObject*)storage);
+    memcpy(block, ts_start, length * sizeof(double));
+    PyArray_CLEARFLAGS((PyArrayObject*)storage, NPY_ARRAY_WRITEABLE);
 
-    current_inarg_pointer += data_size;
+    PyObject* value = time_series_from_definition(block, storage);
+    if (value == nullptr || value == Py_None) {
+        Py_DECREF(storage);
+        return value;
+    }
 
-    // Create a Python dictionary to hold all the information
-    PyObject* py_dict = PyDict_New();
-    PyDict_SetItemString(py_dict, "time_basis", PyFloat_FromDouble(time_basis));
-    PyDict_SetItemString(py_dict, "data_type", PyFloat_FromDouble(data_type));
-    PyDict_SetItemString(py_dict, "timestamps", py_timestamps);
-    PyDict_SetItemString(py_dict, "data", py_data);
+    // The copy doubles as the key for the next comparison, so the block is copied only once
+    Py_XDECREF(entry.value);
+    Py_XDECREF(entry.storage);
+    entry.value = value;
+    entry.storage = storage;
+    Py_INCREF(value);
+    return value;
+}
 
-    LogDebug("  TS Marshalling: Successfully created Python dictionary.");
-    return py_dict;
+void ReleaseTimeSeriesResources() {
+    for (auto& entry : ts_input_cache) {
+        Py_XDECREF(entry.value);
+        Py_XDECREF(entry.storage);
+    }
+    ts_input_cache.clear();
+    Py_XDECREF(time_series_type);
+    time_series_type = nullptr;
+    Py_XDECREF(time_series_builder_type);
+    time_series_builder_type = nullptr;
 }
 
-// Marshal a Python dictionary (time series) to GoldSim outargs buffer
+// Writes the 7 header doubles of a GoldSim Time Series Definition
+static void write_time_series_header(double*& current_outarg_pointer, double time_basis, double data_type, const SeriesLayout& layout) {
+    if (layout.num_rows == 0) { // Scalar Time Series
+        GSPY_LOG_DEBUG("  Python->GoldSim: Scalar time series, num_rows = 0, num_cols = 0");
+    }
+    else if (layout.num_cols == 0) { // Vector Time Series
+        GSPY_LOG_EVENT(TsVectorOut, layout.num_rows);
+    }
+    else { // Matrix Time Series
+        GSPY_LOG_EVENT(TsMatrixOut, layout.num_rows, layout.num_cols);
+    }
+
+    // Write the GoldSim Time Series header
+    GSPY_LOG_EVENT(TsHeaderBasis, time_basis, data_type);
+    GSPY_LOG_EVENT(TsHeaderShape, layout.num_rows, layout.num_cols, layout.num_series);
+
+    *current_outarg_pointer++ = 20.0;
+    *current_outarg_pointer++ = -3.0;
+    *current_outarg_pointer++ = time_basis;
+    *current_outarg_pointer++ = data_type;
+    *current_outarg_pointer++ = static_cast<double>(layout.num_rows);
+    *current_outarg_pointer++ = static_cast<double>(layout.num_cols);
+    *current_outarg_pointer++ = static_cast<double>(layout.num_series);
+}
+
+// =================================================================
+// Decimation: fitting returned series into max_points
+// =================================================================
+
+// Largest-Triangle-Three-Buckets: keeps the first and last points and, from each of the
+// max_points - 2 buckets in between, the point that forms the largest triangle with the
+// previously kept point and the next bucket's average. Rows/columns add their areas.
+static void select_points_lttb(const double* t, const double* data, npy_intp row_stride, npy_intp rows, npy_intp n, npy_intp max_points,
+                               std::vector<npy_intp>& keep) {
+    keep.clear();
+    keep.push_back(0);
+    double bucket_width = static_cast<double>(n - 2) / static_cast<double>(max_points - 2);
+    std::vector<double> next_average(rows);
+    npy_intp a = 0;
+    for (npy_intp b = 0; b < max_points - 2; ++b) {
+        npy_intp start = 1 + static_cast<npy_intp>(b * bucket_width);
+        npy_intp end = 1 + static_cast<npy_intp>((b + 1) * bucket_width);
+        npy_intp next_start = end;
+        npy_intp next_end = std::min<npy_intp>(1 + static_cast<npy_intp>((b + 2) * bucket_width), n);
+        if (b == max_points - 3) { next_start = n - 1; next_end = n; }
+
+        double next_t = 0.0;
+        std::fill(next_average.begin(), next_average.end(), 0.0);
+        for (npy_intp i = next_start; i < next_end; ++i) {
+            next_t += t[i];
+            for (npy_intp r = 0; r < rows; ++r) next_average[r] += data[r * row_stride + i];
+        }
+        double count = static_cast<double>(next_end - next_start);
+        next_t /= count;
+        for (npy_intp r = 0; r < rows; ++r) next_average[r] /= count;
+
+        double best_area = -1.0;
+        npy_intp best = start;
+        for (npy_intp i = start; i < end; ++i) {
+            double area = 0.0;
+            for (npy_intp r = 0; r < rows; ++r) {
+                const double* y = data + r * row_stride;
+                area += std::abs((t[a] - next_t) * (y[i] - y[a]) - (t[a] - t[i]) * (next_average[r] - y[a]));
+            }
+            if (area > best_area) {
+                best_area = area;
+                best = i;
+            }
+        }
+        keep.push_back(best);
+        a = best;
+    }
+    keep.push_back(n - 1);
+}
+
+// Largest vertical distance between points a..b and the straight line from a to b, over all rows
+static double segment_error(const double* t, const double* data, npy_intp row_stride, npy_intp rows, npy_intp a, npy_intp b, npy_intp& worst) {
+    double max_error = 0.0;
+    worst = a;
+    for (npy_intp i = a + 1; i < b; ++i) {
+        double f = t[b] > t[a] ? (t[i] - t[a]) / (t[b] - t[a]) : 0.0;
+        double error = 0.0;
+        for (npy_intp r = 0; r < rows; ++r) {
+            const double* y = data + r * row_stride;
+            error = std::max(error, std::abs(y[i] - (y[a] + f * (y[b] - y[a]))));
+        }
+        if (error > max_error) {
+            max_error = error;
+            worst = i;
+        }
+    }
+    return max_error;
+}
+
+// Piecewise-linear simplification (Ramer-Douglas-Peucker, worst segment first): keeps
+// splitting the segment with the largest deviation until every point is within tolerance
+// of the kept line, or max_points are used. Returns the deviation that remains.
+static double select_points_simplify(const double* t, const double* data, npy_intp row_stride, npy_intp rows, npy_intp n, npy_intp max_points,
+                                     double tolerance, std::vector<npy_intp>& keep) {
+    struct Segment { double error; npy_intp a, b, worst; };
+    auto less = [](const Segment& x, const Segment& y) { return x.error < y.error; };
+    std::vector<Segment> heap;
+    std::vector<char> kept(n, 0);
+    kept[0] = kept[n - 1] = 1;
+    npy_intp kept_count = 2;
+
+    Segment first{ 0.0, 0, n - 1, 0 };
+    first.error = segment_error(t, data, row_stride, rows, 0, n - 1, first.worst);
+    heap.push_back(first);
+    while (!heap.empty() && kept_count < max_points) {
+        std::pop_heap(heap.begin(), heap.end(), less);
+        Segment segment = heap.back();
+        heap.pop_back();
+        if (segment.error <= tolerance) {
+            heap.push_back(segment); // Still needed to report the remaining deviation
+            break;
+        }
+        kept[segment.worst] = 1;
+        ++kept_count;
+        for (npy_intp end : { segment.a, segment.b }) {
+            Segment part{ 0.0, std::min(end, segment.worst), std::max(end, segment.worst), 0 };
+            part.error = segment_error(t, data, row_stride, rows, part.a, part.b, part.worst);
+            heap.push_back(part);
+            std::push_heap(heap.begin(), heap.end(), less);
+        }
+    }
+
+    keep.clear();
+    for (npy_intp i = 0; i < n; ++i) {
+        if (kept[i]) keep.push_back(i);
+    }
+    double remaining = 0.0;
+    for (const Segment& segment : heap) remaining = std::max(remaining, segment.error);
+    return remaining;
+}
+
+bool CheckTimeSeriesShape(long num_rows, long num_cols, const nlohmann::json& config, std::string& errorMessage) {
+    long expected_rows = 0;
+    long expected_cols = 0;
+    if (config.contains("dimensions")) {
+        const auto& dims = config["dimensions"];
+        if (!dims.empty()) expected_rows = dims[0].get<long>();
+        if (dims.size() > 1) expected_cols = dims[1].get<long>();
+    }
+    if (num_rows == expected_rows && num_cols == expected_cols) return true;
+
+    auto describe = [](long rows, long cols) {
+        if (rows <= 0) return std::string("a scalar time series");
+        if (cols <= 0) return "a vector time series of " + std::to_string(rows) + " row(s)";
+        return "a " + std::to_string(rows) + " x " + std::to_string(cols) + " matrix time series";
+    };
+    errorMessage = "Error: Time series output '" + config.value("name", "") + "' returned " + describe(num_rows, num_cols) +
+                   " but its 'dimensions' declare " + describe(expected_rows, expected_cols) + ".";
+    return false;
+}
+
+// Writes a complete GoldSim Time Series Definition, all series in one pass. Rows of one
+// series are row_stride doubles apart. Series longer than the output's max_points are
+// reduced with its "decimation" method. Shapes that differ from the output's dimensions, or
+// that have more series than num_series, are rejected so outargs can never be overrun.
+static bool write_time_series(double*& current_outarg_pointer, double time_basis, double data_type, const SeriesLayout& layout,
+                              const double* timestamps, const double* data, npy_intp row_stride, const nlohmann::json& config,
+                              std::string& errorMessage) {
+    npy_intp max_points = config.value("max_points", 1);
+    npy_intp max_series = config.value("num_series", 1);
+    std::string decimation = config.value("decimation", "none");
+    npy_intp n = layout.num_time_points;
+    npy_intp rows = (layout.num_rows > 0 ? layout.num_rows : 1) * (layout.num_cols > 0 ? layout.num_cols : 1);
+
+    if (!CheckTimeSeriesShape(static_cast<long>(layout.num_rows), static_cast<long>(layout.num_cols), config, errorMessage)) {
+        return false;
+    }
+    if (layout.num_series > max_series) {
+        errorMessage = "Error: Time series output '" + config.value("name", "") + "' returned " + std::to_string(layout.num_series) +
+                       " series but its 'num_series' is " + std::to_string(max_series) + ".";
+        return false;
+    }
+    if (n > max_points && (decimation == "none" || max_points < 2)) {
+        errorMessage = "Error: Time series output '" + config.value("name", "") + "' returned " + std::to_string(n) +
+                       " points but 'max_points' is " + std::to_string(max_points) +
+                       (decimation == "none" ? ". Increase 'max_points' or set 'decimation'." : ". Decimation needs 'max_points' >= 2.");
+        return false;
+    }
+    if (n > max_points && decimation != "lttb" && decimation != "simplify") {
+        errorMessage = "Error: Unknown 'decimation' method '" + decimation + "' (expected 'lttb', 'simplify' or 'none').";
+        return false;
+    }
+
+    write_time_series_header(current_outarg_pointer, time_basis, data_type, layout);
+
+    // Each series: point count, timestamps, then values
+    GSPY_LOG_EVENT(TsWriteSeries, layout.num_series, n, series_size(layout));
+    std::vector<npy_intp> keep;
+    for (npy_intp s = 0; s < layout.num_series; ++s) {
+        const double* series_times = timestamps + s * layout.timestamps_stride;
+        const double* series_data = data + s * layout.data_stride;
+
+        if (n <= max_points) {
+            *current_outarg_pointer++ = static_cast<double>(n);
+            memcpy(current_outarg_pointer, series_times, n * sizeof(double));
+            current_outarg_pointer += n;
+            for (npy_intp r = 0; r < rows; ++r) {
+                memcpy(current_outarg_pointer, series_data + r * row_stride, n * sizeof(double));
+                current_outarg_pointer += n;
+            }
+            continue;
+        }
+
+        if (decimation == "lttb") {
+            select_points_lttb(series_times, series_data, row_stride, rows, n, max_points, keep);
+        }
+        else {
+            double tolerance = config.value("tolerance", 0.0);
+            double remaining = select_points_simplify(series_times, series_data, row_stride, rows, n, max_points, tolerance, keep);
+            if (remaining > tolerance) {
+                GSPY_LOG_WARNING("Time series output '" + config.value("name", "") + "': " + std::to_string(max_points) +
+                                 " points leave a deviation of " + std::to_string(remaining) + ", above the tolerance of " + std::to_string(tolerance) + ".");
+            }
+        }
+        GSPY_LOG_EVENT(TsDecimated, s, n, keep.size(), decimation);
+
+        npy_intp kept = static_cast<npy_intp>(keep.size());
+        *current_outarg_pointer++ = static_cast<double>(kept);
+        for (npy_intp i = 0; i < kept; ++i) current_outarg_pointer[i] = series_times[keep[i]];
+        current_outarg_pointer += kept;
+        for (npy_intp r = 0; r < rows; ++r) {
+            const double* row = series_data + r * row_stride;
+            for (npy_intp i = 0; i < kept; ++i) current_outarg_pointer[i] = row[keep[i]];
+            current_outarg_pointer += kept;
+        }
+    }
+    return true;
+}
+
+// =================================================================
+// gspy.TimeSeriesBuilder: append-only time series output
+// =================================================================
+
+// Grows one point at a time in bridge-owned buffers. Each row/column keeps its values
+// contiguous (time is GoldSim's fastest axis), so growth doubles the capacity and moves
+// each row once: appends are amortized O(1) and the output is one memcpy per row.
+struct TimeSeriesBuilderObject {
+    PyObject_HEAD
+    double time_basis;
+    double data_type;
+    npy_intp num_rows;          // 0 for scalar time series
+    npy_intp num_cols;          // 0 for scalar and vector time series
+    npy_intp values_per_point;  // rows * cols, at least 1
+    npy_intp count;
+    npy_intp capacity;
+    double* timestamps;         // capacity entries
+    double* values;             // values_per_point rows of capacity entries each
+};
+
+// Builders alive in this interpreter, so each realization can start them empty
+static std::vector<TimeSeriesBuilderObject*> live_builders;
+
+static const npy_intp initial_builder_capacity = 64;
+
+static bool builder_grow(TimeSeriesBuilderObject* builder) {
+    npy_intp new_capacity = builder->capacity ? builder->capacity * 2 : initial_builder_capacity;
+    double* timestamps = (double*)PyMem_Realloc(builder->timestamps, new_capacity * sizeof(double));
+    if (timestamps == nullptr) return false;
+    builder->timestamps = timestamps;
+
+    double* values = (double*)PyMem_Malloc(new_capacity * builder->values_per_point * sizeof(double));
+    if (values == nullptr) return false;
+    for (npy_intp r = 0; r < builder->values_per_point; ++r) {
+        if (builder->count > 0) memcpy(values + r * new_capacity, builder->values + r * builder->capacity, builder->count * sizeof(double));
+    }
+    PyMem_Free(builder->values);
+    builder->values = values;
+    builder->capacity = new_capacity;
+    return true;
+}
+
+// append(t, value): value is a float for scalar series, else an array of shape (rows[, cols])
+static PyObject* builder_append(PyObject* self, PyObject* args) {
+    TimeSeriesBuilderObject* builder = (TimeSeriesBuilderObject*)self;
+    double t;
+    PyObject* py_value;
+    if (!PyArg_ParseTuple(args, "dO", &t, &py_value)) return nullptr;
+
+    if (builder->count > 0 && t < builder->timestamps[builder->count - 1]) {
+        std::string message = "TimeSeriesBuilder times must not decrease (" + std::to_string(t) + " after " +
+                              std::to_string(builder->timestamps[builder->count - 1]) + ")";
+        PyErr_SetString(PyExc_ValueError, message.c_str());
+        return nullptr;
+    }
+    if (builder->count == builder->capacity && !builder_grow(builder)) {
+        return PyErr_NoMemory();
+    }
+
+    npy_intp i = builder->count;
+    if (builder->values_per_point == 1 && (PyFloat_Check(py_value) || PyLong_Check(py_value))) {
+        double value = PyFloat_AsDouble(py_value);
+        if (value == -1.0 && PyErr_Occurred()) return nullptr;
+        builder->values[i] = value;
+    }
+    else {
+        if (!ensure_numpy()) return nullptr;
+        PyArrayObject* array = (PyArrayObject*)PyArray_FROM_OTF(py_value, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+        if (array == nullptr) return nullptr;
+        if (PyArray_SIZE(array) != builder->values_per_point) {
+            PyErr_Format(PyExc_ValueError, "TimeSeriesBuilder.append expected %zd value(s) per point, got %zd",
+                         (Py_ssize_t)builder->values_per_point, (Py_ssize_t)PyArray_SIZE(array));
+            Py_DECREF(array);
+            return nullptr;
+        }
+        const double* src = (const double*)PyArray_DATA(array);
+        for (npy_intp r = 0; r < builder->values_per_point; ++r) {
+            builder->values[r * builder->capacity + i] = src[r];
+        }
+        Py_DECREF(array);
+    }
+    builder->timestamps[i] = t;
+    ++builder->count;
+    Py_RETURN_NONE;
+}
+
+static void builder_reset(TimeSeriesBuilderObject* builder) {
+    builder->count = 0; // Keep the buffers; the next realization usually needs the same capacity
+}
+
+static PyObject* builder_reset_method(PyObject* self, PyObject*) {
+    builder_reset((TimeSeriesBuilderObject*)self);
+    Py_RETURN_NONE;
+}
+
+static SeriesLayout builder_layout(const TimeSeriesBuilderObject* builder) {
+    SeriesLayout layout;
+    layout.num_time_points = builder->count;
+    layout.num_rows = builder->num_rows;
+    layout.num_cols = builder->num_cols;
+    layout.data_stride = series_size(layout);
+    return layout;
+}
+
+// to_timeseries(): snapshot of the points so far as an independent gspy.TimeSeries
+static PyObject* builder_to_timeseries(PyObject* self, PyObject*) {
+    TimeSeriesBuilderObject* builder = (TimeSeriesBuilderObject*)self;
+    if (!ensure_numpy() || !ensure_time_series_type()) return nullptr;
+
+    SeriesLayout layout = builder_layout(builder);
+    npy_intp dims[4];
+    int ndim = data_shape(layout, dims);
+    PyObject* timestamps = PyArray_SimpleNew(1, &layout.num_time_points, NPY_FLOAT64);
+    PyObject* data = timestamps ? PyArray_SimpleNew(ndim, dims, NPY_FLOAT64) : nullptr;
+    if (data == nullptr) {
+        Py_XDECREF(timestamps);
+        return nullptr;
+    }
+    memcpy(PyArray_DATA((PyArrayObject*)timestamps), builder->timestamps, builder->count * sizeof(double));
+    double* out = (double*)PyArray_DATA((PyArrayObject*)data);
+    for (npy_intp r = 0; r < builder->values_per_point; ++r) {
+        memcpy(out + r * builder->count, builder->values + r * builder->capacity, builder->count * sizeof(double));
+    }
+    return wrap_time_series_arrays((PyTypeObject*)time_series_type, builder->time_basis, builder->data_type, layout, timestamps, data);
+}
+
+static Py_ssize_t builder_length(PyObject* self) {
+    return ((TimeSeriesBuilderObject*)self)->count;
+}
+
+// gspy.TimeSeriesBuilder(rows=0, cols=0, time_basis=0.0, data_type=0.0)
+static PyObject* builder_new(PyTypeObject* type, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = { "rows", "cols", "time_basis", "data_type", nullptr };
+    Py_ssize_t rows = 0;
+    Py_ssize_t cols = 0;
+    double time_basis = 0.0;
+    double data_type = 0.0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|nndd", (char**)kwlist, &rows, &cols, &time_basis, &data_type)) {
+        return nullptr;
+    }
+    if (rows < 0 || cols < 0 || (cols > 0 && rows == 0)) {
+        PyErr_SetString(PyExc_ValueError, "TimeSeriesBuilder needs rows >= 0, and rows > 0 when cols > 0");
+        return nullptr;
+    }
+
+    TimeSeriesBuilderObject* builder = (TimeSeriesBuilderObject*)type->tp_alloc(type, 0);
+    if (builder == nullptr) return nullptr;
+    builder->time_basis = time_basis;
+    builder->data_type = data_type;
+    builder->num_rows = rows;
+    builder->num_cols = cols;
+    builder->values_per_point = (rows > 0 ? rows : 1) * (cols > 0 ? cols : 1);
+    live_builders.push_back(builder);
+    return (PyObject*)builder;
+}
+
+static void builder_dealloc(PyObject* self) {
+    TimeSeriesBuilderObject* builder = (TimeSeriesBuilderObject*)self;
+    for (size_t i = 0; i < live_builders.size(); ++i) {
+        if (live_builders[i] == builder) {
+            live_builders.erase(live_builders.begin() + i);
+            break;
+        }
+    }
+    PyMem_Free(builder->timestamps);
+    PyMem_Free(builder->values);
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+static PyMethodDef builder_methods[] = {
+    {"append", builder_append, METH_VARARGS, "Append one point: append(t, value)"},
+    {"reset", builder_reset_method, METH_NOARGS, "Discard all points (done automatically at the start of each realization)"},
+    {"to_timeseries", builder_to_timeseries, METH_NOARGS, "Copy the points so far into a gspy.TimeSeries"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+static PyType_Slot time_series_builder_slots[] = {
+    {Py_tp_new, (void*)builder_new},
+    {Py_tp_dealloc, (void*)builder_dealloc},
+    {Py_tp_methods, (void*)builder_methods},
+    {Py_sq_length, (void*)builder_length},
+    {Py_tp_doc, (void*)"Append-only time series output, emptied at the start of every realization."},
+    {0, nullptr}
+};
+
+static PyType_Spec time_series_builder_spec = {
+    "gspy.TimeSeriesBuilder",
+    sizeof(TimeSeriesBuilderObject),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    time_series_builder_slots
+};
+
+bool AddTimeSeriesTypes(PyObject* module) {
+    if (!ensure_time_series_type()) return false;
+    if (time_series_builder_type == nullptr) {
+        time_series_builder_type = PyType_FromSpec(&time_series_builder_spec);
+        if (time_series_builder_type == nullptr) {
+            LogError("Error: Could not create the gspy.TimeSeriesBuilder type.");
+            PyErr_Print();
+            return false;
+        }
+    }
+    Py_INCREF(time_series_type);
+    if (PyModule_AddObject(module, "TimeSeries", time_series_type) != 0) return false;
+    Py_INCREF(time_series_builder_type);
+    return PyModule_AddObject(module, "TimeSeriesBuilder", time_series_builder_type) == 0;
+}
+
+void ResetTimeSeriesBuilders() {
+    for (TimeSeriesBuilderObject* builder : live_builders) {
+        builder_reset(builder);
+    }
+}
+
+// Marshal a gspy.TimeSeries or Python dictionary (time series) to GoldSim outargs buffer
 bool MarshalPythonTimeSeriesToGoldSim(PyObject* py_object, const nlohmann::json& config, double*& current_outarg_pointer, std::string& errorMessage) {
-    Log("--- TimeSeriesManager: Marshalling Python Time Series to GoldSim ---");
+    GSPY_LOG(LOG_INFO, "--- TimeSeriesManager: Marshalling Python Time Series to GoldSim ---");
+
+    // Native objects: read the fields straight from the C struct, no NumPy or dict lookups
+    if (time_series_type != nullptr && PyObject_TypeCheck(py_object, (PyTypeObject*)time_series_type)) {
+        TimeSeriesObject* ts = (TimeSeriesObject*)py_object;
+        if (!write_time_series(current_outarg_pointer, ts->time_basis, ts->data_type, ts->layout, ts->timestamps_ptr, ts->data_ptr,
+                               ts->layout.num_time_points, config, errorMessage)) {
+            return false;
+        }
+        GSPY_LOG_DEBUG("  Python->GoldSim: Successfully marshalled time series to GoldSim");
+        return true;
+    }
+
+    // Builders: header plus one memcpy for the timestamps and one per row/column
+    if (time_series_builder_type != nullptr && PyObject_TypeCheck(py_object, (PyTypeObject*)time_series_builder_type)) {
+        TimeSeriesBuilderObject* builder = (TimeSeriesBuilderObject*)py_object;
+        if (!write_time_series(current_outarg_pointer, builder->time_basis, builder->data_type, builder_layout(builder), builder->timestamps,
+                               builder->values, builder->capacity, config, errorMessage)) {
+            return false;
+        }
+        GSPY_LOG_EVENT(TsBuilderWritten, builder->count);
+        return true;
+    }
 
     if (!PyDict_Check(py_object)) {
-        errorMessage = "Error: Python script was expected to return a dictionary for a Time Series output.";
+        errorMessage = "Error: Python script was expected to return a gspy.TimeSeries, gspy.TimeSeriesBuilder or a dictionary for a Time Series output.";
         return false;
     }
 
@@ -107,84 +1056,226 @@ bool MarshalPythonTimeSeriesToGoldSim(PyObject* py_object, const nlohmann::json&
     PyObject* py_data = PyDict_GetItemString(py_object, "data");
     PyObject* py_time_basis = PyDict_GetItemString(py_object, "time_basis");
     PyObject* py_data_type = PyDict_GetItemString(py_object, "data_type");
+    PyObject* py_num_series = PyDict_GetItemString(py_object, "num_series"); // Optional
 
     if (!py_timestamps || !py_data || !py_time_basis || !py_data_type) {
         errorMessage = "Error: Python dictionary for Time Series is missing required keys ('timestamps', 'data', 'time_basis', 'data_type').";
         return false;
     }
+    if (!ensure_numpy()) {
+        errorMessage = "Error: Could not initialize NumPy C-API in TimeSeriesManager.";
+        return false;
+    }
 
-    PyArrayObject* timestamps_array = (PyArrayObject*)py_timestamps;
-    PyArrayObject* data_array = (PyArrayObject*)py_data;
+    PyArrayObject* timestamps_array = (PyArrayObject*)PyArray_FROM_OTF(py_timestamps, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+    PyArrayObject* data_array = timestamps_array ? (PyArrayObject*)PyArray_FROM_OTF(py_data, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY) : nullptr;
+    if (!data_array) {
+        PyErr_Clear();
+        Py_XDECREF(timestamps_array);
+        errorMessage = "Error: Time series 'timestamps' and 'data' must be convertible to float64 arrays.";
+        return false;
+    }
 
     // Get the dimensions directly from the shape of the returned NumPy data array
     int ndim = PyArray_NDIM(data_array);
     npy_intp* shape = PyArray_SHAPE(data_array);
-    double num_rows = 0;
-    double num_cols = 0;
 
-    LogDebug("  Python->GoldSim: Array ndim = " + std::to_string(ndim));
+    GSPY_LOG_EVENT(TsArrayNdim, ndim);
     std::string shape_str = "(";
     for (int i = 0; i < ndim; ++i) {
         if (i > 0) shape_str += ", ";
         shape_str += std::to_string(shape[i]);
     }
     shape_str += ")";
-    LogDebug("  Python->GoldSim: Array shape = " + shape_str);
+    GSPY_LOG_DEBUG("  Python->GoldSim: Array shape = " + shape_str);
+
+    npy_intp num_series = py_num_series ? PyLong_AsSsize_t(py_num_series) : 1;
+    if (num_series == -1 && PyErr_Occurred()) PyErr_Clear();
 
-    if (ndim == 1) { // Scalar Time Series
-        LogDebug("  Python->GoldSim: Scalar time series, num_rows = 0, num_cols = 0");
+    SeriesLayout layout;
+    bool ok = describe_series_arrays(timestamps_array, data_array, num_series, layout, errorMessage) &&
+              write_time_series(current_outarg_pointer, PyFloat_AsDouble(py_time_basis), PyFloat_AsDouble(py_data_type), layout,
+                                (const double*)PyArray_DATA(timestamps_array), (const double*)PyArray_DATA(data_array),
+                                layout.num_time_points, config, errorMessage);
+    if (ok) {
+        GSPY_LOG_DEBUG("  Python->GoldSim: Successfully marshalled time series to GoldSim");
     }
-    else if (ndim == 2) { // Vector Time Series
-        num_rows = static_cast<double>(shape[0]);
-        LogDebug("  Python->GoldSim: Vector time series, num_rows = " + std::to_string(num_rows));
+    Py_DECREF(timestamps_array);
+    Py_DECREF(data_array);
+    return ok;
+}
+
+// =================================================================
+// gspy.resample: interpolate a time series onto new timestamps
+// =================================================================
+
+enum class ResampleMethod { Linear, StepPrevious, StepNext };
+
+// One merge-style pass over sorted timestamps. For each new time, records the two source
+// points to blend and the weight of the second, so every row of a series reuses the same
+// brackets. Values outside the source range are held at the first/last point, like np.interp.
+// Unsorted new_times still work; the search simply restarts when a time goes backwards.
+static void compute_brackets(const double* times, npy_intp n, const double* new_times, npy_intp m, ResampleMethod method,
+                             npy_intp* lo, npy_intp* hi, double* weight) {
+    npy_intp k = 0; // Last source index with times[k] <= t (or 0)
+    for (npy_intp j = 0; j < m; ++j) {
+        double t = new_times[j];
+        if (j > 0 && t < new_times[j - 1]) k = 0;
+        while (k + 1 < n && times[k + 1] <= t) ++k;
+
+        if (t < times[0]) {
+            lo[j] = hi[j] = 0;
+            weight[j] = 0.0;
+            continue;
+        }
+        if (method == ResampleMethod::StepPrevious || k + 1 >= n) {
+            lo[j] = hi[j] = k;
+            weight[j] = 0.0;
+        }
+        else if (method == ResampleMethod::StepNext) {
+            npy_intp next = times[k] == t ? k : k + 1;
+            lo[j] = hi[j] = next;
+            weight[j] = 0.0;
+        }
+        else {
+            lo[j] = k;
+            hi[j] = k + 1;
+            weight[j] = (t - times[k]) / (times[k + 1] - times[k]);
+        }
     }
-    else if (ndim == 3) { // Matrix Time Series
-        num_rows = static_cast<double>(shape[0]);
-        num_cols = static_cast<double>(shape[1]);
-        LogDebug("  Python->GoldSim: Matrix time series, num_rows = " + std::to_string(num_rows) + ", num_cols = " + std::to_string(num_cols));
+}
+
+// Applies the brackets to one row. The bracketing values are gathered into contiguous
+// chunks first, so the blend runs as packed SSE2/AVX arithmetic in Lerp.
+static void apply_brackets(const double* row, npy_intp m, const npy_intp* lo, const npy_intp* hi, const double* weight, double* out) {
+    const npy_intp chunk_size = 256;
+    double a[chunk_size];
+    double b[chunk_size];
+    for (npy_intp start = 0; start < m; start += chunk_size) {
+        npy_intp count = std::min(chunk_size, m - start);
+        for (npy_intp j = 0; j < count; ++j) {
+            a[j] = row[lo[start + j]];
+            b[j] = row[hi[start + j]];
+        }
+        Lerp(a, b, weight + start, out + start, static_cast<size_t>(count));
     }
+}
+
+PyObject* PythonResample(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = { "ts", "new_times", "method", nullptr };
+    PyObject* py_ts;
+    PyObject* py_new_times;
+    const char* method_name = "linear";
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|s", (char**)kwlist, &py_ts, &py_new_times, &method_name)) {
+        return nullptr;
+    }
+
+    ResampleMethod method;
+    if (strcmp(method_name, "linear") == 0) method = ResampleMethod::Linear;
+    else if (strcmp(method_name, "previous") == 0) method = ResampleMethod::StepPrevious;
+    else if (strcmp(method_name, "next") == 0) method = ResampleMethod::StepNext;
     else {
-        errorMessage = "Error: Unsupported array dimensions: " + std::to_string(ndim);
-        return false;
+        PyErr_Format(PyExc_ValueError, "Unknown resample method '%s' (expected 'linear', 'previous' or 'next')", method_name);
+        return nullptr;
+    }
+    if (!ensure_numpy() || !ensure_time_series_type()) {
+        PyErr_SetString(PyExc_RuntimeError, "gspy.TimeSeries is not available.");
+        return nullptr;
     }
 
-    // Write the GoldSim Time Series header
-    LogDebug("  Python->GoldSim: Writing header - ts_id=20.0, format=-3.0, time_basis=" + std::to_string(PyFloat_AsDouble(py_time_basis)) + ", data_type=" + std::to_string(PyFloat_AsDouble(py_data_type)));
-    LogDebug("  Python->GoldSim: Writing header - num_rows=" + std::to_string(num_rows) + ", num_cols=" + std::to_string(num_cols) + ", num_series=1.0");
-    
-    *current_outarg_pointer++ = 20.0;
-    *current_outarg_pointer++ = -3.0;
-    *current_outarg_pointer++ = PyFloat_AsDouble(py_time_basis);
-    *current_outarg_pointer++ = PyFloat_AsDouble(py_data_type);
-    *current_outarg_pointer++ = num_rows;
-    *current_outarg_pointer++ = num_cols;
-    *current_outarg_pointer++ = 1.0; // num_series (always 1 for now)
-
-    // Write timestamps
-    npy_intp ts_array_size = PyArray_SIZE(timestamps_array);
-    LogDebug("  Python->GoldSim: Writing " + std::to_string(ts_array_size) + " timestamps");
-    *current_outarg_pointer++ = static_cast<double>(ts_array_size);
-    
-    if (PyArray_DATA(timestamps_array) == nullptr) {
-        errorMessage = "Error: Timestamps array data pointer is null";
-        return false;
+    // Accept a gspy.TimeSeries or anything with the time series mapping keys
+    PyObject* source = py_ts;
+    if (!PyObject_TypeCheck(py_ts, (PyTypeObject*)time_series_type)) {
+        PyObject* kw = PyMapping_Check(py_ts) ? PyDict_New() : nullptr;
+        static const char* keys[] = { "timestamps", "data", "time_basis", "data_type", "num_series" };
+        for (int i = 0; kw != nullptr && i < 5; ++i) {
+            PyObject* value = PyMapping_GetItemString(py_ts, keys[i]);
+            if (value == nullptr) {
+                PyErr_Clear();
+                if (i < 2) Py_CLEAR(kw);
+                continue;
+            }
+            PyDict_SetItemString(kw, keys[i], value);
+            Py_DECREF(value);
+        }
+        if (kw == nullptr) {
+            PyErr_SetString(PyExc_TypeError, "resample() expects a gspy.TimeSeries or a time series dictionary");
+            return nullptr;
+        }
+        PyObject* empty = PyTuple_New(0);
+        source = PyObject_Call(time_series_type, empty, kw);
+        Py_DECREF(empty);
+        Py_DECREF(kw);
+        if (source == nullptr) return nullptr;
+    }
+    else {
+        Py_INCREF(source);
+    }
+    TimeSeriesObject* ts = (TimeSeriesObject*)source;
+    const SeriesLayout& in_layout = ts->layout;
+    if (in_layout.num_time_points < 1) {
+        Py_DECREF(source);
+        PyErr_SetString(PyExc_ValueError, "resample() needs a time series with at least one time point");
+        return nullptr;
     }
-    
-    memcpy(current_outarg_pointer, PyArray_DATA(timestamps_array), ts_array_size * sizeof(double));
-    current_outarg_pointer += ts_array_size;
 
-    // Write data
-    npy_intp data_array_size = PyArray_SIZE(data_array);
-    LogDebug("  Python->GoldSim: Writing " + std::to_string(data_array_size) + " data values");
-    
-    if (PyArray_DATA(data_array) == nullptr) {
-        errorMessage = "Error: Data array data pointer is null";
-        return false;
+    // Target times: another time series (its first series' timestamps) or a 1-D array
+    PyObject* new_times;
+    if (PyObject_TypeCheck(py_new_times, (PyTypeObject*)time_series_type)) {
+        TimeSeriesObject* target = (TimeSeriesObject*)py_new_times;
+        npy_intp m = target->layout.num_time_points;
+        new_times = PyArray_SimpleNew(1, &m, NPY_FLOAT64);
+        if (new_times != nullptr) memcpy(PyArray_DATA((PyArrayObject*)new_times), target->timestamps_ptr, m * sizeof(double));
+    }
+    else {
+        new_times = PyArray_FROM_OTF(py_new_times, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY | NPY_ARRAY_ENSURECOPY);
+        if (new_times != nullptr && PyArray_NDIM((PyArrayObject*)new_times) != 1) {
+            Py_CLEAR(new_times);
+            PyErr_SetString(PyExc_ValueError, "new_times must be 1-D");
+        }
+    }
+    if (new_times == nullptr) {
+        Py_DECREF(source);
+        return nullptr;
     }
-    
-    memcpy(current_outarg_pointer, PyArray_DATA(data_array), data_array_size * sizeof(double));
-    current_outarg_pointer += data_array_size;
 
-    LogDebug("  Python->GoldSim: Successfully marshalled time series to GoldSim");
-    return true;
-}
\ No newline at end of file
+    SeriesLayout out_layout = in_layout;
+    out_layout.num_time_points = PyArray_SIZE((PyArrayObject*)new_times);
+    out_layout.timestamps_stride = 0;
+    out_layout.data_stride = series_size(out_layout);
+    npy_intp dims[4];
+    int ndim = data_shape(out_layout, dims);
+    PyObject* out_data = PyArray_SimpleNew(ndim, dims, NPY_FLOAT64);
+    if (out_data == nullptr) {
+        Py_DECREF(new_times);
+        Py_DECREF(source);
+        return nullptr;
+    }
+
+    npy_intp n = in_layout.num_time_points;
+    npy_intp m = out_layout.num_time_points;
+    npy_intp rows_per_series = series_size(in_layout) / n;
+    bool shared_times = in_layout.num_series == 1 || in_layout.timestamps_stride == 0;
+    const double* target_times = (const double*)PyArray_DATA((PyArrayObject*)new_times);
+    double* out = (double*)PyArray_DATA((PyArrayObject*)out_data);
+    std::vector<npy_intp> lo(m), hi(m);
+    std::vector<double> weight(m);
+
+    // Only C buffers are touched below, so other Python threads may run meanwhile
+    Py_BEGIN_ALLOW_THREADS
+    for (npy_intp s = 0; s < in_layout.num_series; ++s) {
+        if (s == 0 || !shared_times) {
+            compute_brackets(ts->timestamps_ptr + s * in_layout.timestamps_stride, n, target_times, m, method, lo.data(), hi.data(), weight.data());
+        }
+        const double* series_data = ts->data_ptr + s * in_layout.data_stride;
+        double* series_out = out + s * out_layout.data_stride;
+        for (npy_intp r = 0; r < rows_per_series; ++r) {
+            apply_brackets(series_data + r * n, m, lo.data(), hi.data(), weight.data(), series_out + r * m);
+        }
+    }
+    Py_END_ALLOW_THREADS
+
+    PyObject* result = wrap_time_series_arrays((PyTypeObject*)time_series_type, ts->time_basis, ts->data_type, out_layout, new_times, out_data);
+    Py_DECREF(source);
+    return result;
+}
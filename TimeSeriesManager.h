@@ -3,8 +3,35 @@
 #include "json.hpp"
 #include <string>
 
-// This function takes GoldSim data and marshals it INTO a Python object.
+// Registers the gspy.TimeSeries and gspy.TimeSeriesBuilder types on the gspy module.
+bool AddTimeSeriesTypes(PyObject* module);
+
+// Empties every gspy.TimeSeriesBuilder. Called at the start of each realization.
+void ResetTimeSeriesBuilders();
+
+// This function takes GoldSim data and marshals it INTO a Python object (a gspy.TimeSeries).
 PyObject* MarshalGoldSimTimeSeriesToPython(double*& current_inarg_pointer, const nlohmann::json& config);
 
+// Returns how many doubles the GoldSim Time Series Definition starting at ts_start occupies,
+// without creating any Python objects.
+long GetGoldSimTimeSeriesLength(const double* ts_start);
+
+// Checks a time series' rows and columns (0 when absent) against the output's "dimensions":
+// [] for scalar, [rows] for vector and [rows, cols] for matrix time series. outargs space is
+// reserved from those dimensions, so any other shape would overrun it.
+bool CheckTimeSeriesShape(long num_rows, long num_cols, const nlohmann::json& config, std::string& errorMessage);
+
+// Cached variant for inputs: when the definition block for input slot is bit-identical to
+// the previous call, returns the same Python object without re-wrapping anything. The cached
+// object owns read-only copies of its arrays, so it stays valid after inargs changes.
+PyObject* MarshalCachedGoldSimTimeSeriesToPython(double* ts_start, size_t slot, const nlohmann::json& config);
+
+// Releases all cached time series inputs and the time series types. Call before Py_Finalize.
+void ReleaseTimeSeriesResources();
+
+// Python-callable: gspy.resample(ts, new_times, method="linear"). Returns a new gspy.TimeSeries
+// sampled at new_times using "linear", "previous" (step) or "next" (step) interpolation.
+PyObject* PythonResample(PyObject* self, PyObject* args, PyObject* kwargs);
+
 // This is the single, correct declaration for the function.
 bool MarshalPythonTimeSeriesToGoldSim(PyObject* py_object, const nlohmann::json& config, double*& current_outarg_pointer, std::string& errorMessage);
\ No newline at end of file
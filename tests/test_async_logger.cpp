@@ -0,0 +1,129 @@
+#include "../Logger.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+
+static const std::string test_file = "test_async_log.txt";
+
+// Reads every line logged after the line containing marker
+static std::vector<std::string> lines_after(const std::string& marker) {
+    std::ifstream in(test_file);
+    std::vector<std::string> lines;
+    std::string line;
+    bool found = false;
+    while (std::getline(in, line)) {
+        if (found) lines.push_back(line);
+        else if (line.find(marker) != std::string::npos) found = true;
+    }
+    return lines;
+}
+
+static std::string message(int thread, int i) {
+    std::string text = "T" + std::to_string(thread) + " #" + std::to_string(i);
+    // Every 100th record spans several ring slots
+    if (i % 100 == 0) text += " " + std::string(600, static_cast<char>('a' + thread));
+    return text;
+}
+
+static void produce(int threads, int per_thread) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([t, per_thread] {
+            for (int i = 0; i < per_thread; ++i) LogInfo(message(t, i));
+        });
+    }
+    for (auto& worker : workers) worker.join();
+}
+
+// Every record from every thread arrives exactly once, whole and in per-thread order
+static bool check_block_policy() {
+    const int threads = 4, per_thread = 5000;
+    LogAlways("--- block policy ---");
+    StartAsyncLogger(256, LogOverflow::Block);
+    produce(threads, per_thread);
+    StopAsyncLogger();
+
+    std::vector<int> next(threads, 0);
+    bool ok = true;
+    for (const std::string& line : lines_after("--- block policy ---")) {
+        size_t start = line.find("INFO: T");
+        if (start == std::string::npos) continue;
+        int t = line[start + 7] - '0';
+        ok &= line.substr(start + 6) == message(t, next[t]);
+        ++next[t];
+    }
+    for (int t = 0; t < threads; ++t) ok &= next[t] == per_thread;
+    std::cout << "  Block policy: " << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok;
+}
+
+// A tiny queue drops records, and the writer reports how many
+static bool check_drop_policy() {
+    const int threads = 4, per_thread = 5000;
+    LogAlways("--- drop policy ---");
+    StartAsyncLogger(64, LogOverflow::Drop);
+    produce(threads, per_thread);
+    StopAsyncLogger();
+
+    long long written = 0, dropped = 0;
+    for (const std::string& line : lines_after("--- drop policy ---")) {
+        if (line.find("INFO: T") != std::string::npos) ++written;
+        size_t pos = line.find("WARNING: ");
+        if (pos != std::string::npos && line.find("dropped") != std::string::npos) dropped += std::stoll(line.substr(pos + 9));
+    }
+    bool ok = written + dropped == threads * per_thread;
+    std::cout << "  Drop policy: " << (ok ? "PASS" : "FAIL") << " (" << written << " written, " << dropped << " dropped)" << std::endl;
+    return ok;
+}
+
+// ERROR records are on disk as soon as LogError returns
+static bool check_error_flush() {
+    StartAsyncLogger(1024, LogOverflow::Drop);
+    LogError("async error marker");
+    bool ok = false;
+    std::ifstream in(test_file);
+    std::string line;
+    while (std::getline(in, line)) ok |= line.find("ERROR: async error marker") != std::string::npos;
+    StopAsyncLogger();
+    std::cout << "  Error flush: " << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Caller-side cost of one INFO record, synchronous and asynchronous
+static void benchmark() {
+    const int count = 200000;
+    std::string text = "Marshalling output #3: Type='timeseries', 8760 points";
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) LogInfo(text);
+    double sync_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+
+    StartAsyncLogger(1 << 16, LogOverflow::Block);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) LogInfo(text);
+    double async_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+    StopAsyncLogger();
+
+    std::cout << "  Per call: synchronous " << sync_ns << " ns, asynchronous " << async_ns << " ns" << std::endl;
+}
+
+int main() {
+    std::cout << "Testing asynchronous logger..." << std::endl;
+    InitLogger(test_file, LOG_INFO);
+
+    bool ok = true;
+    ok &= check_block_policy();
+    ok &= check_drop_policy();
+    ok &= check_error_flush();
+    std::cout << "Benchmark:" << std::endl;
+    benchmark();
+
+    std::error_code ignored;
+    std::filesystem::remove(test_file, ignored);  // Fails on Windows while the log is still open
+    std::cout << (ok ? "All asynchronous logger tests passed." : "Asynchronous logger tests FAILED.") << std::endl;
+    return ok ? 0 : 1;
+}
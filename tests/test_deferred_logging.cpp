@@ -0,0 +1,66 @@
+#include "../Logger.h"
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <filesystem>
+
+static int evaluations = 0;
+
+static std::string counted_message(int value) {
+    ++evaluations;
+    return "value = " + std::to_string(value);
+}
+
+// Before: the message is built, then Log() drops it
+static void eager_debug(int count) {
+    for (int i = 0; i < count; ++i) LogDebug("  Output #" + std::to_string(i) + ": Type='timeseries'");
+}
+
+// After: the level check comes first
+static void deferred_debug(int count) {
+    for (int i = 0; i < count; ++i) GSPY_LOG_DEBUG("  Output #" + std::to_string(i) + ": Type='timeseries'");
+}
+
+// Compiled with DEBUG sites stripped
+#undef GSPY_COMPILED_LOG_LEVEL
+#define GSPY_COMPILED_LOG_LEVEL 2
+static void stripped_debug(int count) {
+    for (int i = 0; i < count; ++i) GSPY_LOG_DEBUG("  Output #" + std::to_string(i) + ": Type='timeseries'");
+}
+#undef GSPY_COMPILED_LOG_LEVEL
+#define GSPY_COMPILED_LOG_LEVEL 3
+
+template <typename F>
+static double ns_per_call(F function, int count) {
+    auto start = std::chrono::steady_clock::now();
+    function(count);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+int main() {
+    std::cout << "Testing deferred logging..." << std::endl;
+    std::string test_file = "test_deferred_log.txt";
+    InitLogger(test_file, LOG_ERROR);
+
+    // Disabled levels must not evaluate the message; enabled ones evaluate it once
+    GSPY_LOG_DEBUG(counted_message(1));
+    GSPY_LOG_INFO(counted_message(2));
+    bool ok = evaluations == 0;
+    SetLogLevelFromInt(LOG_INFO);
+    GSPY_LOG_INFO(counted_message(3));
+    GSPY_LOG_DEBUG(counted_message(4));
+    ok &= evaluations == 1;
+    std::cout << "  Message evaluation: " << (ok ? "PASS" : "FAIL") << std::endl;
+
+    SetLogLevelFromInt(LOG_ERROR);
+    const int count = 2000000;
+    std::cout << "Benchmark (log_level 0, DEBUG sites):" << std::endl;
+    std::cout << "  Eager LogDebug:  " << ns_per_call(eager_debug, count) << " ns per call" << std::endl;
+    std::cout << "  GSPY_LOG_DEBUG:  " << ns_per_call(deferred_debug, count) << " ns per call" << std::endl;
+    std::cout << "  Stripped site:   " << ns_per_call(stripped_debug, count) << " ns per call" << std::endl;
+
+    std::error_code ignored;
+    std::filesystem::remove(test_file, ignored);  // Fails on Windows while the log is still open
+    std::cout << (ok ? "All deferred logging tests passed." : "Deferred logging tests FAILED.") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+#include "../FlightRecorder.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+
+static const std::string test_file = "test_flight_recorder_log.txt";
+
+static std::vector<std::string> read_log() {
+    std::vector<std::string> lines;
+    std::ifstream in(test_file);
+    std::string line;
+    while (std::getline(in, line)) lines.push_back(line);
+    return lines;
+}
+
+static size_t count_containing(const std::vector<std::string>& lines, const std::string& text) {
+    size_t count = 0;
+    for (const auto& line : lines) count += line.find(text) != std::string::npos;
+    return count;
+}
+
+// Only the newest `capacity` events survive, and they are dumped oldest first
+static bool check_ring() {
+    for (int i = 0; i < 40; ++i) GSPY_LOG_EVENT(MethodCalled, i);
+    bool ok = count_containing(read_log(), "MethodID") == 0;     // Nothing logged at log_level 0
+
+    DumpFlightRecorder("test failure");
+    std::vector<std::string> lines = read_log();
+    ok &= count_containing(lines, "MethodID") == 16;
+    ok &= count_containing(lines, "last 16 event(s) before test failure") == 1;
+    size_t first = 0;
+    while (first < lines.size() && lines[first].find("MethodID") == std::string::npos) ++first;
+    ok &= first + 15 < lines.size() && lines[first].find("MethodID: 24") != std::string::npos &&
+          lines[first + 15].find("MethodID: 39") != std::string::npos;
+    std::cout << "  Last N events, oldest first: " << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok;
+}
+
+// A second dump only shows what happened since the first
+static bool check_incremental_dump() {
+    size_t dumps = count_containing(read_log(), "flight recorder: last");
+    DumpFlightRecorder("nothing new");
+    bool ok = count_containing(read_log(), "flight recorder: last") == dumps;
+
+    std::string long_name(200, 'n');
+    GSPY_RECORD_EVENT(InputSize, 7, long_name, 3);
+    GSPY_LOG_EVENT(TsHeaderBasis, 1.5, 0.0);
+    DumpFlightRecorder("second failure");
+    std::vector<std::string> lines = read_log();
+    ok &= count_containing(lines, "last 2 event(s) before second failure") == 1;
+    ok &= count_containing(lines, "  Input #7 '" + std::string(80, 'n') + "': 3 value(s)") == 1;  // Truncated to the slot
+    ok &= count_containing(lines, "time_basis=1.500000, data_type=0.000000") == 1;
+    std::cout << "  Incremental dumps and string truncation: " << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Per-event cost at log_level 0 with the recorder on and off
+static void benchmark(int count) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) GSPY_LOG_EVENT(TsHeaderShape, i, i + 1, 2);
+    double on_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+
+    StopFlightRecorder();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) GSPY_LOG_EVENT(TsHeaderShape, i, i + 1, 2);
+    double off_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+
+    std::cout << "  Recorder on:  " << on_ns << " ns per event" << std::endl;
+    std::cout << "  Recorder off: " << off_ns << " ns per event" << std::endl;
+}
+
+int main() {
+    std::cout << "Testing flight recorder..." << std::endl;
+    InitLogger(test_file, LOG_ERROR);
+    StartFlightRecorder(16);
+
+    bool ok = true;
+    ok &= check_ring();
+    ok &= check_incremental_dump();
+
+    std::cout << "Benchmark (log_level 0, 1,000,000 events):" << std::endl;
+    benchmark(1000000);
+
+    std::remove(test_file.c_str());  // Fails harmlessly on Windows while the log is still open
+    std::cout << (ok ? "All flight recorder tests passed." : "Flight recorder tests FAILED.") << std::endl;
+    return ok ? 0 : 1;
+}
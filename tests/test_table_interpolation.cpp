@@ -0,0 +1,151 @@
+#include "../TableInterpolation.h"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+// Builds a GoldSim table sequence: dimension count, sizes, labels, layer-major values
+static std::vector<double> make_table(const std::vector<std::vector<double>>& labels, std::mt19937& rng) {
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    std::vector<double> table = { static_cast<double>(labels.size()) };
+    std::size_t count = 1;
+    for (const auto& axis : labels) {
+        table.push_back(static_cast<double>(axis.size()));
+        count *= axis.size();
+    }
+    for (const auto& axis : labels) table.insert(table.end(), axis.begin(), axis.end());
+    for (std::size_t i = 0; i < count; ++i) table.push_back(value(rng));
+    return table;
+}
+
+// Reference: clamp, binary search and blend the corners with explicit product weights
+static double reference(const std::vector<double>& table, const double* x) {
+    std::size_t dim = static_cast<std::size_t>(table[0]);
+    std::size_t sizes[3] = { 1, 1, 1 };
+    const double* labels[3] = {};
+    const double* p = table.data() + 1 + dim;
+    for (std::size_t d = 0; d < dim; ++d) {
+        sizes[d] = static_cast<std::size_t>(table[1 + d]);
+        labels[d] = p;
+        p += sizes[d];
+    }
+    std::size_t cell[3] = {};
+    double weight[3] = {};
+    for (std::size_t d = 0; d < dim; ++d) {
+        double v = std::min(std::max(x[d], labels[d][0]), labels[d][sizes[d] - 1]);
+        cell[d] = std::min<std::size_t>(std::upper_bound(labels[d], labels[d] + sizes[d], v) - labels[d] - 1, sizes[d] - 2);
+        weight[d] = (v - labels[d][cell[d]]) / (labels[d][cell[d] + 1] - labels[d][cell[d]]);
+    }
+    double result = 0.0;
+    for (std::size_t k = 0; k < (std::size_t(1) << dim); ++k) {
+        std::size_t r = cell[0] + (k & 1), c = dim > 1 ? cell[1] + (k >> 1 & 1) : 0, l = dim > 2 ? cell[2] + (k >> 2 & 1) : 0;
+        double w = 1.0;
+        for (std::size_t d = 0; d < dim; ++d) w *= (k >> d & 1) ? weight[d] : 1.0 - weight[d];
+        std::size_t offset = dim == 1 ? r : l * sizes[0] * sizes[1] + r * sizes[1] + c;
+        result += w * p[offset];
+    }
+    return result;
+}
+
+static std::vector<double> axis(std::size_t n, double scale) {
+    std::vector<double> labels(n);
+    for (std::size_t i = 0; i < n; ++i) labels[i] = scale * i + 0.1 * i * i;
+    return labels;
+}
+
+static bool check_table(const std::vector<std::vector<double>>& labels, std::mt19937& rng) {
+    std::vector<double> table = make_table(labels, rng);
+    std::size_t dim = labels.size();
+    const std::size_t count = 1000;
+    std::vector<std::vector<double>> coords(dim, std::vector<double>(count));
+    for (std::size_t d = 0; d < dim; ++d) {
+        // Reach past both ends to exercise clamping
+        std::uniform_real_distribution<double> position(labels[d].front() - 1.0, labels[d].back() + 1.0);
+        for (double& x : coords[d]) x = position(rng);
+    }
+
+    const double* pointers[3];
+    std::size_t steps[3] = { 1, 1, 1 };
+    for (std::size_t d = 0; d < dim; ++d) pointers[d] = coords[d].data();
+    std::vector<double> results(count);
+    std::size_t hints[3] = {};
+    InterpolateTable(table.data(), pointers, steps, count, results.data(), hints);
+
+    double worst = 0.0;
+    for (std::size_t q = 0; q < count; ++q) {
+        double x[3];
+        for (std::size_t d = 0; d < dim; ++d) x[d] = coords[d][q];
+        worst = std::max(worst, std::fabs(results[q] - reference(table, x)));
+    }
+    bool ok = worst < 1e-12;
+    std::cout << "  " << dim << "D: " << (ok ? "PASS" : "FAIL") << " (max error " << worst << ")" << std::endl;
+    return ok;
+}
+
+// Slowly moving scalar queries (one per GoldSim step), with the bracket hints carried between
+// calls and with them reset every call
+static void benchmark_steps(std::mt19937& rng) {
+    std::vector<std::vector<double>> labels = { axis(200, 1.0), axis(100, 2.0), axis(20, 5.0) };
+    std::vector<double> table = make_table(labels, rng);
+    const std::size_t steps_count = 1000000;
+    std::size_t steps[3] = {};
+
+    for (int carry_hints = 1; carry_hints >= 0; --carry_hints) {
+        double sum = 0.0;
+        std::size_t hints[3] = {};
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < steps_count; ++i) {
+            double x[3] = { labels[0].back() * i / steps_count, 50.0 + i % 7, 20.0 };
+            const double* pointers[3] = { &x[0], &x[1], &x[2] };
+            double result;
+            if (!carry_hints) hints[0] = hints[1] = hints[2] = 0;
+            InterpolateTable(table.data(), pointers, steps, 1, &result, hints);
+            sum += result;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  " << steps_count << " stepping 3D queries, " << (carry_hints ? "cached" : "reset") << " hints: "
+                  << ms << " ms (checksum " << sum << ")" << std::endl;
+    }
+}
+
+// One batched call over random points
+static void benchmark_batch(std::mt19937& rng) {
+    std::vector<std::vector<double>> labels = { axis(200, 1.0), axis(100, 2.0), axis(20, 5.0) };
+    std::vector<double> table = make_table(labels, rng);
+    const std::size_t count = 1000000;
+    std::vector<std::vector<double>> coords(3, std::vector<double>(count));
+    for (std::size_t d = 0; d < 3; ++d) {
+        std::uniform_real_distribution<double> position(labels[d].front(), labels[d].back());
+        for (double& x : coords[d]) x = position(rng);
+    }
+    const double* pointers[3] = { coords[0].data(), coords[1].data(), coords[2].data() };
+    std::size_t steps[3] = { 1, 1, 1 };
+    std::size_t hints[3] = {};
+    std::vector<double> results(count);
+
+    auto start = std::chrono::steady_clock::now();
+    InterpolateTable(table.data(), pointers, steps, count, results.data(), hints);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << count << " random 3D queries in one batch: " << ms << " ms" << std::endl;
+}
+
+int main() {
+    std::cout << "Testing table interpolation kernel..." << std::endl;
+    std::mt19937 rng(42);
+
+    bool ok = true;
+    ok &= check_table({ axis(9, 1.0) }, rng);
+    ok &= check_table({ axis(7, 1.0), axis(2, 3.0) }, rng);
+    ok &= check_table({ axis(6, 1.0), axis(5, 2.0), axis(4, 0.5) }, rng);
+    ok &= check_table({ axis(300, 0.1), axis(3, 1.0), axis(2, 1.0) }, rng);
+
+    std::cout << "Benchmark:" << std::endl;
+    benchmark_steps(rng);
+    benchmark_batch(rng);
+
+    std::cout << (ok ? "All interpolation tests passed." : "Interpolation tests FAILED.") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+#include "../TableTranspose.h"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+
+// Reference: the triple loop LookupTableManager used before the tiled kernel
+static void naive_layer_major(const std::vector<double>& src, std::vector<double>& dst, std::size_t rows, std::size_t cols, std::size_t layers) {
+    std::size_t out = 0;
+    for (std::size_t layer = 0; layer < layers; ++layer) {
+        for (std::size_t row = 0; row < rows; ++row) {
+            for (std::size_t col = 0; col < cols; ++col) {
+                dst[out++] = src[row * cols * layers + col * layers + layer];
+            }
+        }
+    }
+}
+
+static bool check_shape(std::size_t rows, std::size_t cols, std::size_t layers) {
+    std::vector<double> src(rows * cols * layers);
+    for (std::size_t i = 0; i < src.size(); ++i) src[i] = static_cast<double>(i) * 0.5;
+
+    std::vector<double> expected(src.size()), actual(src.size());
+    naive_layer_major(src, expected, rows, cols, layers);
+    TransposeMatrix(src.data(), actual.data(), rows * cols, layers);
+
+    bool ok = expected == actual;
+    std::cout << "  " << rows << "x" << cols << "x" << layers << ": " << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Microbenchmark: best of several runs for the naive loop and the tiled kernel
+static void benchmark(std::size_t rows, std::size_t cols, std::size_t layers, int repeats) {
+    std::vector<double> src(rows * cols * layers, 1.0), dst(src.size());
+    double naive_best = 1e30, tiled_best = 1e30;
+
+    for (int i = 0; i < repeats; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        naive_layer_major(src, dst, rows, cols, layers);
+        auto middle = std::chrono::steady_clock::now();
+        TransposeMatrix(src.data(), dst.data(), rows * cols, layers);
+        auto end = std::chrono::steady_clock::now();
+
+        double naive_ms = std::chrono::duration<double, std::milli>(middle - start).count();
+        double tiled_ms = std::chrono::duration<double, std::milli>(end - middle).count();
+        if (naive_ms < naive_best) naive_best = naive_ms;
+        if (tiled_ms < tiled_best) tiled_best = tiled_ms;
+    }
+
+    std::cout << "  " << rows << "x" << cols << "x" << layers << ": naive " << naive_best << " ms, tiled "
+              << tiled_best << " ms (" << naive_best / tiled_best << "x)" << std::endl;
+}
+
+int main() {
+    std::cout << "Testing 3D table transpose kernel..." << std::endl;
+
+    bool ok = true;
+    // Exact tiles, partial tiles, odd sizes and degenerate shapes
+    ok &= check_shape(32, 32, 32);
+    ok &= check_shape(200, 200, 50);
+    ok &= check_shape(7, 13, 5);
+    ok &= check_shape(1, 1, 9);
+    ok &= check_shape(3, 5, 1);
+    ok &= check_shape(33, 1, 31);
+
+    std::cout << "Benchmark (best of 10):" << std::endl;
+    benchmark(200, 200, 50, 10);
+    benchmark(500, 500, 20, 10);
+
+    std::cout << (ok ? "All transpose tests passed." : "Transpose tests FAILED.") << std::endl;
+    return ok ? 0 : 1;
+}
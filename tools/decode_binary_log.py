@@ -0,0 +1,131 @@
+"""Decode a GSPy binary log (written with "log_binary": true) into the text log format.
+
+Usage:
+    python decode_binary_log.py my_script_log.bin [output.txt] [--micro]
+
+Without an output file the text goes to stdout. --micro adds microseconds to each
+timestamp. The event templates are read from the file header, so logs written by any
+GSPy version decode without changes to this script.
+"""
+import struct
+import sys
+import time
+
+MAGIC = b"GSPYBLOG"
+LEVEL_PREFIXES = ["ERROR: ", "WARNING: ", "INFO: ", "DEBUG: "]
+TEXT_EVENT = 0  # Preformatted message, written verbatim
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def at_end(self):
+        return self.pos >= len(self.data)
+
+    def byte(self):
+        value = self.data[self.pos]
+        self.pos += 1
+        return value
+
+    def varint(self):
+        value, shift = 0, 0
+        while True:
+            b = self.byte()
+            value |= (b & 0x7F) << shift
+            if b < 0x80:
+                return value
+            shift += 7
+
+    def string(self):
+        size = self.varint()
+        value = self.data[self.pos:self.pos + size].decode("utf-8", errors="replace")
+        self.pos += size
+        return value
+
+    def double(self):
+        (value,) = struct.unpack_from("<d", self.data, self.pos)
+        self.pos += 8
+        return value
+
+    def arg(self):
+        kind = self.byte()
+        if kind == 1:
+            raw = self.varint()
+            return str((raw >> 1) ^ -(raw & 1))
+        if kind == 2:
+            return "%f" % self.double()  # Matches std::to_string(double)
+        if kind == 3:
+            return self.string()
+        raise ValueError("unknown argument type %d at offset %d" % (kind, self.pos - 1))
+
+
+def fill(template, args):
+    parts = template.split("{}")
+    out = [parts[0]]
+    for i, part in enumerate(parts[1:]):
+        out.append(args[i] if i < len(args) else "{}")
+        out.append(part)
+    return "".join(out)
+
+
+def decode(data, out, micro=False):
+    reader = Reader(data)
+    if data[:8] != MAGIC:
+        raise ValueError("not a GSPy binary log")
+    reader.pos = 8
+    version = reader.byte()
+    if version != 1:
+        raise ValueError("unsupported binary log version %d" % version)
+    (anchor_us,) = struct.unpack_from("<q", data, reader.pos)
+    reader.pos += 8
+
+    events = []
+    for _ in range(reader.varint()):
+        level = reader.byte()
+        name = reader.string()
+        template = reader.string()
+        events.append((level, name, template))
+
+    now_us = anchor_us
+    while not reader.at_end():
+        try:
+            event = reader.varint()
+            now_us += reader.varint()
+            args = [reader.arg() for _ in range(reader.byte())]
+        except (IndexError, struct.error):
+            out.write("(log truncated at offset %d)\n" % reader.pos)
+            break
+
+        stamp = time.strftime("%Y-%m-%d %H:%M:%S", time.localtime(now_us // 1000000))
+        if micro:
+            stamp += ".%06d" % (now_us % 1000000)
+        if event == TEXT_EVENT:
+            text = args[0] if args else ""
+        elif event < len(events):
+            level, _, template = events[event]
+            text = LEVEL_PREFIXES[level] + fill(template, args)
+        else:
+            text = "(unknown event %d) %s" % (event, " ".join(args))
+        out.write("%s - %s\n" % (stamp, text))
+
+
+def main(argv):
+    micro = "--micro" in argv
+    paths = [a for a in argv[1:] if a != "--micro"]
+    if not paths:
+        sys.stderr.write(__doc__)
+        return 2
+    with open(paths[0], "rb") as f:
+        data = f.read()
+    if len(paths) > 1:
+        with open(paths[1], "w", encoding="utf-8") as out:
+            decode(data, out, micro)
+    else:
+        decode(data, sys.stdout, micro)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))